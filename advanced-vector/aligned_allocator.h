@@ -0,0 +1,145 @@
+#pragma once
+#include "vector.h"
+
+#include <new>
+
+// Размер строки кэша. std::hardware_destructive_interference_size зависит от флагов компиляции,
+// поэтому его нельзя использовать в раскладке типов заголовочной библиотеки
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+namespace detail
+{
+    constexpr size_t RoundUpPow2(size_t value) noexcept
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+}  // namespace detail
+
+// Аллокатор буферов, выровненных по Alignment (по умолчанию - по строке кэша или по alignof(T), если он больше).
+// Выделяет память выровненным operator new и округляет размер буфера до кратного Alignment:
+// буфер не делит строки кэша с соседними объектами кучи, а через usable_size запас становится вместимостью.
+// Подходит для типов с alignas больше alignof(std::max_align_t) и для векторных алгоритмов,
+// которым важно, чтобы загрузки не пересекали границы строк кэша
+template <typename T, size_t Alignment = std::max(alignof(T), CACHE_LINE_SIZE)>
+struct AlignedAllocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "Alignment must not be less than alignof(T)");
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, std::max(Alignment, alignof(U))>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U, size_t OtherAlignment>
+    AlignedAllocator(const AlignedAllocator<U, OtherAlignment>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        if (n > (SIZE_MAX - Alignment) / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(operator new(AllocationSize(n), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        operator delete(p, AllocationSize(n), std::align_val_t(Alignment));
+    }
+
+    // Вместимость с учётом округления размера буфера до кратного Alignment.
+    // Для неё AllocationSize совпадает с размером, выделенным под n элементов
+    size_t usable_size(T* /*p*/, size_t n) const noexcept
+    {
+        return AllocationSize(n) / sizeof(T);
+    }
+
+    template <typename U, size_t OtherAlignment>
+    bool operator==(const AlignedAllocator<U, OtherAlignment>&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U, size_t OtherAlignment>
+    bool operator!=(const AlignedAllocator<U, OtherAlignment>&) const noexcept
+    {
+        return false;
+    }
+
+private:
+    static size_t AllocationSize(size_t n) noexcept
+    {
+        return (n * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+    }
+};
+
+// Вектор с буфером, выровненным по строке кэша
+template <typename T>
+using AlignedVector = Vector<T, AlignedAllocator<T>>;
+
+// Элемент, выровненный по Alignment и дополненный до кратного ему размера.
+// В векторе таких элементов каждый начинается с границы Alignment
+template <typename T, size_t Alignment>
+struct alignas(std::max(Alignment, alignof(T))) Padded
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    Padded() = default;
+
+    Padded(const T& other) : value(other) {}
+
+    Padded(T&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : value(std::move(other)) {}
+
+    template <typename... Args>
+    explicit Padded(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...)
+    {
+    }
+
+    T& operator*() noexcept
+    {
+        return value;
+    }
+
+    const T& operator*() const noexcept
+    {
+        return value;
+    }
+
+    T* operator->() noexcept
+    {
+        return &value;
+    }
+
+    const T* operator->() const noexcept
+    {
+        return &value;
+    }
+
+    T value{};
+};
+
+template <typename T, size_t Alignment>
+struct IsTriviallyRelocatable<Padded<T, Alignment>> : IsTriviallyRelocatable<T> {};
+
+// Элемент, занимающий целые строки кэша: соседние элементы не попадают в одну строку,
+// и потоки, изменяющие разные элементы (например, счётчики по ядрам), не мешают друг другу (false sharing)
+template <typename T>
+using CacheAligned = Padded<T, CACHE_LINE_SIZE>;
+
+// Элемент, выровненный по наименьшей степени двойки не меньше его размера (но не больше строки кэша).
+// Элемент размером до строки кэша никогда не пересекает её границу, а в одну строку помещается
+// несколько элементов; больший элемент начинается с границы строки
+template <typename T>
+using CacheFitted = Padded<T, std::min(detail::RoundUpPow2(sizeof(T)), CACHE_LINE_SIZE)>;
@@ -0,0 +1,518 @@
+// Микробенчмарки Vector в сравнении с std::vector.
+// Формат вывода повторяет JSON-отчёт Google Benchmark (--benchmark_format=json),
+// поэтому результаты можно сравнивать теми же инструментами (например, compare.py).
+//
+// Сборка: g++ -std=c++17 -O2 -DNDEBUG benchmark.cpp -o benchmark
+// Параметры:
+//   --max_size=N     наибольший размер контейнера (степени 10 от 10 до N, не больше 10^8), по умолчанию 10^6
+//   --max_bytes=N    пропускать замеры, где контейнер занимает больше N байт, по умолчанию 2^30
+//   --min_time=S     минимальное время одного замера в секундах, по умолчанию 0.1
+//   --filter=TEXT    запускать только замеры, в имени которых есть TEXT
+//   --format=F       json (по умолчанию) или console
+
+#include "vector.h"
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    // Тип с нетривиальными операциями копирования и перемещения, как Obj в тестах
+    struct Obj
+    {
+        Obj() = default;
+
+        explicit Obj(int id) : id(id), name(std::to_string(id)) {}
+
+        int id = 0;
+        std::string name;
+    };
+
+    // Тип, все специальные функции которого объявлены пользователем и не бросают исключений
+    struct C
+    {
+        C() noexcept
+        {
+            ++def_ctor;
+        }
+        C(const C& /*other*/) noexcept
+        {
+            ++copy_ctor;
+        }
+        C(C&& /*other*/) noexcept
+        {
+            ++move_ctor;
+        }
+        C& operator=(const C& other) noexcept
+        {
+            if (this != &other)
+            {
+                ++copy_assign;
+            }
+            return *this;
+        }
+        C& operator=(C&& /*other*/) noexcept
+        {
+            ++move_assign;
+            return *this;
+        }
+        ~C()
+        {
+            ++dtor;
+        }
+
+        inline static size_t def_ctor = 0;
+        inline static size_t copy_ctor = 0;
+        inline static size_t move_ctor = 0;
+        inline static size_t copy_assign = 0;
+        inline static size_t move_assign = 0;
+        inline static size_t dtor = 0;
+    };
+
+    // Крупная запись без нетривиальных операций
+    struct Pod256
+    {
+        unsigned char bytes[256];
+    };
+
+    template <typename T>
+    T MakeValue(size_t i)
+    {
+        if constexpr (std::is_same_v<T, int>)
+        {
+            return static_cast<int>(i);
+        }
+        else if constexpr (std::is_same_v<T, Obj>)
+        {
+            return Obj(static_cast<int>(i));
+        }
+        else if constexpr (std::is_same_v<T, Pod256>)
+        {
+            Pod256 pod{};
+            pod.bytes[0] = static_cast<unsigned char>(i);
+            return pod;
+        }
+        else
+        {
+            return T{};
+        }
+    }
+
+    template <typename T>
+    unsigned char FirstByte(const T& value)
+    {
+        return *reinterpret_cast<const unsigned char*>(&value);
+    }
+
+    // Не даёт компилятору выбросить вычисление value
+    template <typename T>
+    void DoNotOptimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    // Единый интерфейс к Vector и std::vector
+    template <typename T>
+    struct VectorOps
+    {
+        using Container = Vector<T>;
+        static constexpr std::string_view NAME = "Vector";
+
+        static void PushBack(Container& c, const T& value)
+        {
+            c.PushBack(value);
+        }
+        static void EmplaceBack(Container& c, size_t i)
+        {
+            c.EmplaceBack(MakeValue<T>(i));
+        }
+        static void Insert(Container& c, size_t pos, const T& value)
+        {
+            c.Insert(c.begin() + pos, value);
+        }
+        static void Erase(Container& c, size_t pos)
+        {
+            c.Erase(c.begin() + pos);
+        }
+        static void Reserve(Container& c, size_t n)
+        {
+            c.Reserve(n);
+        }
+        static void Resize(Container& c, size_t n)
+        {
+            c.Resize(n);
+        }
+        static size_t Size(const Container& c)
+        {
+            return c.Size();
+        }
+    };
+
+    template <typename T>
+    struct StdVectorOps
+    {
+        using Container = std::vector<T>;
+        static constexpr std::string_view NAME = "std::vector";
+
+        static void PushBack(Container& c, const T& value)
+        {
+            c.push_back(value);
+        }
+        static void EmplaceBack(Container& c, size_t i)
+        {
+            c.emplace_back(MakeValue<T>(i));
+        }
+        static void Insert(Container& c, size_t pos, const T& value)
+        {
+            c.insert(c.begin() + pos, value);
+        }
+        static void Erase(Container& c, size_t pos)
+        {
+            c.erase(c.begin() + pos);
+        }
+        static void Reserve(Container& c, size_t n)
+        {
+            c.reserve(n);
+        }
+        static void Resize(Container& c, size_t n)
+        {
+            c.resize(n);
+        }
+        static size_t Size(const Container& c)
+        {
+            return c.size();
+        }
+    };
+
+    struct Options
+    {
+        size_t max_size = 1'000'000;
+        size_t max_bytes = size_t{ 1 } << 30;
+        double min_time = 0.1;
+        std::string filter;
+        bool json = true;
+    };
+
+    struct Result
+    {
+        std::string name;
+        size_t iterations = 0;
+        double real_time_ns = 0;
+        double cpu_time_ns = 0;
+        double items_per_second = 0;
+    };
+
+    double CpuSeconds()
+    {
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+    }
+
+    class Runner
+    {
+    public:
+        explicit Runner(Options options) : options_(std::move(options)) {}
+
+        // Запускает body(iterations) с растущим числом итераций, пока замер не займёт min_time.
+        // items - количество элементарных операций за одну итерацию (для items_per_second)
+        void Run(const std::string& name, size_t items, const std::function<void(size_t)>& body)
+        {
+            if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos)
+            {
+                return;
+            }
+
+            size_t iterations = 1;
+            for (;;)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                const double cpu_start = CpuSeconds();
+                body(iterations);
+                const double cpu = CpuSeconds() - cpu_start;
+                const double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                if (real >= options_.min_time || iterations >= 1'000'000'000)
+                {
+                    Result result;
+                    result.name = name;
+                    result.iterations = iterations;
+                    result.real_time_ns = real * 1e9 / iterations;
+                    result.cpu_time_ns = cpu * 1e9 / iterations;
+                    result.items_per_second = real > 0 ? static_cast<double>(items) * iterations / real : 0;
+                    if (!options_.json)
+                    {
+                        std::cout << std::left << std::setw(56) << result.name << std::right
+                                  << std::setw(16) << std::fixed << std::setprecision(1) << result.real_time_ns << " ns"
+                                  << std::setw(14) << result.iterations << '\n';
+                    }
+                    results_.push_back(std::move(result));
+                    return;
+                }
+
+                // Оценка числа итераций по образцу Google Benchmark: с запасом, но не более чем в 10 раз
+                const double multiplier = real > 0 ? options_.min_time * 1.4 / real : 10.0;
+                iterations = static_cast<size_t>(iterations * std::min(std::max(multiplier, 1.5), 10.0)) + 1;
+            }
+        }
+
+        const Options& GetOptions() const
+        {
+            return options_;
+        }
+
+        void PrintJson(std::ostream& out) const
+        {
+            const std::time_t now = std::time(nullptr);
+            char date[64];
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+            out << "{\n  \"context\": {\n"
+                << "    \"date\": \"" << date << "\",\n"
+                << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#if defined(NDEBUG)
+                << "    \"library_build_type\": \"release\"\n"
+#else
+                << "    \"library_build_type\": \"debug\"\n"
+#endif
+                << "  },\n  \"benchmarks\": [\n";
+            for (size_t i = 0; i < results_.size(); ++i)
+            {
+                const Result& r = results_[i];
+                out << "    {\n"
+                    << "      \"name\": \"" << r.name << "\",\n"
+                    << "      \"run_name\": \"" << r.name << "\",\n"
+                    << "      \"run_type\": \"iteration\",\n"
+                    << "      \"iterations\": " << r.iterations << ",\n"
+                    << std::setprecision(6) << std::scientific
+                    << "      \"real_time\": " << r.real_time_ns << ",\n"
+                    << "      \"cpu_time\": " << r.cpu_time_ns << ",\n"
+                    << "      \"time_unit\": \"ns\",\n"
+                    << "      \"items_per_second\": " << r.items_per_second << "\n"
+                    << "    }" << (i + 1 < results_.size() ? "," : "") << '\n';
+            }
+            out << "  ]\n}\n";
+        }
+
+    private:
+        Options options_;
+        std::vector<Result> results_;
+    };
+
+    template <typename Ops, typename T>
+    void RunContainerBenchmarks(Runner& runner, std::string_view type_name, size_t n)
+    {
+        using Container = typename Ops::Container;
+
+        std::ostringstream prefix_stream;
+        prefix_stream << Ops::NAME << '<' << type_name << ">/";
+        const std::string prefix = prefix_stream.str();
+        const std::string suffix = "/" + std::to_string(n);
+
+        const T value = MakeValue<T>(1);
+
+        runner.Run(prefix + "PushBack" + suffix, n, [&](size_t iterations)
+            {
+                for (size_t it = 0; it < iterations; ++it)
+                {
+                    Container c;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Ops::PushBack(c, value);
+                    }
+                    DoNotOptimize(c);
+                }
+            });
+
+        runner.Run(prefix + "EmplaceBack" + suffix, n, [&](size_t iterations)
+            {
+                for (size_t it = 0; it < iterations; ++it)
+                {
+                    Container c;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Ops::EmplaceBack(c, i);
+                    }
+                    DoNotOptimize(c);
+                }
+            });
+
+        runner.Run(prefix + "Reserve" + suffix, 1, [&](size_t iterations)
+            {
+                for (size_t it = 0; it < iterations; ++it)
+                {
+                    Container c;
+                    Ops::Reserve(c, n);
+                    DoNotOptimize(c);
+                }
+            });
+
+        runner.Run(prefix + "Resize" + suffix, n, [&](size_t iterations)
+            {
+                for (size_t it = 0; it < iterations; ++it)
+                {
+                    Container c;
+                    Ops::Resize(c, n);
+                    DoNotOptimize(c);
+                }
+            });
+
+        Container source;
+        Ops::Reserve(source, n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            Ops::PushBack(source, MakeValue<T>(i));
+        }
+
+        // Вставка и удаление одного элемента в контейнере размера n
+        const std::pair<const char*, size_t> positions[] = { { "front", 0 }, { "middle", n / 2 }, { "back", n } };
+        for (const auto& [position_name, pos] : positions)
+        {
+            Container c = source;
+            runner.Run(prefix + "InsertErase/" + position_name + suffix, 1, [&, pos = pos](size_t iterations)
+                {
+                    for (size_t it = 0; it < iterations; ++it)
+                    {
+                        Ops::Insert(c, pos, value);
+                        Ops::Erase(c, pos);
+                    }
+                    DoNotOptimize(c);
+                });
+        }
+
+        {
+            Container destination;
+            runner.Run(prefix + "CopyAssign" + suffix, n, [&](size_t iterations)
+                {
+                    for (size_t it = 0; it < iterations; ++it)
+                    {
+                        destination = source;
+                        DoNotOptimize(destination);
+                    }
+                });
+        }
+
+        {
+            Container a = source;
+            Container b;
+            runner.Run(prefix + "MoveAssign" + suffix, 1, [&](size_t iterations)
+                {
+                    for (size_t it = 0; it < iterations; ++it)
+                    {
+                        b = std::move(a);
+                        a = std::move(b);
+                        DoNotOptimize(a);
+                    }
+                });
+        }
+
+        runner.Run(prefix + "Iterate" + suffix, n, [&](size_t iterations)
+            {
+                for (size_t it = 0; it < iterations; ++it)
+                {
+                    size_t checksum = 0;
+                    for (const T& element : source)
+                    {
+                        checksum += FirstByte(element);
+                    }
+                    DoNotOptimize(checksum);
+                }
+            });
+    }
+
+    template <typename T>
+    void RunTypeBenchmarks(Runner& runner, std::string_view type_name)
+    {
+        for (size_t n = 10; n <= runner.GetOptions().max_size && n <= 100'000'000; n *= 10)
+        {
+            // Источник и копия одновременно живут в замерах копирования
+            if (n * sizeof(T) * 2 > runner.GetOptions().max_bytes)
+            {
+                break;
+            }
+            RunContainerBenchmarks<VectorOps<T>, T>(runner, type_name, n);
+            RunContainerBenchmarks<StdVectorOps<T>, T>(runner, type_name, n);
+        }
+    }
+
+    Options ParseOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            const auto value_of = [&](std::string_view key) -> std::string
+                {
+                    return std::string(arg.substr(key.size()));
+                };
+
+            if (arg.rfind("--max_size=", 0) == 0)
+            {
+                options.max_size = std::stoull(value_of("--max_size="));
+            }
+            else if (arg.rfind("--max_bytes=", 0) == 0)
+            {
+                options.max_bytes = std::stoull(value_of("--max_bytes="));
+            }
+            else if (arg.rfind("--min_time=", 0) == 0)
+            {
+                options.min_time = std::stod(value_of("--min_time="));
+            }
+            else if (arg.rfind("--filter=", 0) == 0)
+            {
+                options.filter = value_of("--filter=");
+            }
+            else if (arg == "--format=console")
+            {
+                options.json = false;
+            }
+            else if (arg == "--format=json")
+            {
+                options.json = true;
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown option: " + std::string(arg));
+            }
+        }
+        return options;
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        Runner runner(ParseOptions(argc, argv));
+
+        RunTypeBenchmarks<int>(runner, "int");
+        RunTypeBenchmarks<Obj>(runner, "Obj");
+        RunTypeBenchmarks<C>(runner, "C");
+        RunTypeBenchmarks<Pod256>(runner, "Pod256");
+
+        if (runner.GetOptions().json)
+        {
+            runner.PrintJson(std::cout);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include "vector.h"
+#include "segments.h"
+
+#include <atomic>
+
+// Вектор для одновременного добавления элементов из нескольких потоков без блокировок.
+// Элементы хранятся в сегментах SegmentLayout, которые выделяются по мере роста и никогда не перемещаются,
+// поэтому ссылки на элементы остаются действительными всё время жизни вектора.
+// EmplaceBack занимает слот атомарным fetch_add; сегмент выделяет первый обратившийся к нему поток
+// и публикует его через compare_exchange, проигравшие потоки освобождают свою копию.
+// Чтение по индексу wait-free: два обращения к памяти без циклов и блокировок.
+// Элемент доступен для чтения в другом потоке, если его добавление произошло раньше (happens-before)
+// или IsReady(index) вернул true.
+// Если конструктор элемента или выделение сегмента выбросили исключение, занятый слот остаётся пустым:
+// IsReady для него всегда возвращает false, а Size его учитывает.
+// Аллокатор вызывается из разных потоков одновременно и должен быть потокобезопасным.
+template <typename T, typename Alloc = std::allocator<T>, size_t FirstSegmentSize = 64>
+class ConcurrentVector
+{
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using Layout = SegmentLayout<FirstSegmentSize>;
+    using ReadyFlag = std::atomic<bool>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>, "Alloc::value_type must be T");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "Fancy pointers are not supported");
+
+public:
+    using allocator_type = Alloc;
+
+    ConcurrentVector() = default;
+
+    explicit ConcurrentVector(const Alloc& alloc) noexcept : alloc_(alloc) {}
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    // Деструктор не должен выполняться одновременно с другими операциями
+    ~ConcurrentVector()
+    {
+        for (size_t segment = 0; segment < Layout::SEGMENT_COUNT; ++segment)
+        {
+            T* data = segments_[segment].load(std::memory_order_acquire);
+            if (data == nullptr)
+            {
+                continue;
+            }
+            ReadyFlag* ready = ReadyFlags(data, segment);
+            for (size_t offset = 0; offset < Layout::SegmentSize(segment); ++offset)
+            {
+                if (ready[offset].load(std::memory_order_relaxed))
+                {
+                    std::destroy_at(data + offset);
+                }
+            }
+            DeallocateSegment(data, segment);
+        }
+    }
+
+    // Заранее выделяет сегменты для capacity элементов. Можно вызывать одновременно с EmplaceBack
+    void Reserve(size_t capacity)
+    {
+        for (size_t segment = 0; segment < Layout::SegmentCountFor(capacity); ++segment)
+        {
+            GetOrAllocateSegment(segment);
+        }
+    }
+
+    void PushBack(const T& value)
+    {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value)
+    {
+        EmplaceBack(std::move(value));
+    }
+
+    // Добавляет элемент в конец вектора. Потокобезопасен и не блокирует другие потоки.
+    // Аргументы могут ссылаться на элементы этого же вектора: элементы не перемещаются
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+        const SegmentPosition position = Layout::Locate(index);
+        T* data = GetOrAllocateSegment(position.segment);
+        T* element = new (data + position.offset) T(std::forward<Args>(args)...);
+        ReadyFlags(data, position.segment)[position.offset].store(true, std::memory_order_release);
+        return *element;
+    }
+
+    // Число занятых слотов, включая элементы, которые ещё создаются другими потоками
+    size_t Size() const noexcept
+    {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // Элемент index создан и виден текущему потоку
+    bool IsReady(size_t index) const noexcept
+    {
+        if (index >= Size())
+        {
+            return false;
+        }
+        const SegmentPosition position = Layout::Locate(index);
+        const T* data = segments_[position.segment].load(std::memory_order_acquire);
+        return data != nullptr && ReadyFlags(data, position.segment)[position.offset].load(std::memory_order_acquire);
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        return const_cast<ConcurrentVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept
+    {
+        assert(index < Size());
+        const SegmentPosition position = Layout::Locate(index);
+        return segments_[position.segment].load(std::memory_order_acquire)[position.offset];
+    }
+
+    Alloc GetAllocator() const noexcept
+    {
+        return alloc_;
+    }
+
+private:
+    // Сегмент хранит элементы и следом за ними флаги готовности, всё в одном блоке аллокатора
+    static size_t AllocationSize(size_t segment) noexcept
+    {
+        const size_t size = Layout::SegmentSize(segment);
+        return size + (size * sizeof(ReadyFlag) + sizeof(T) - 1) / sizeof(T);
+    }
+
+    static ReadyFlag* ReadyFlags(const T* data, size_t segment) noexcept
+    {
+        return reinterpret_cast<ReadyFlag*>(const_cast<T*>(data) + Layout::SegmentSize(segment));
+    }
+
+    T* GetOrAllocateSegment(size_t segment)
+    {
+        T* data = segments_[segment].load(std::memory_order_acquire);
+        if (data != nullptr)
+        {
+            return data;
+        }
+
+        T* new_data = AllocTraits::allocate(alloc_, AllocationSize(segment));
+        std::uninitialized_value_construct_n(ReadyFlags(new_data, segment), Layout::SegmentSize(segment));
+        if (segments_[segment].compare_exchange_strong(data, new_data, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return new_data;
+        }
+        // Сегмент уже выделил другой поток
+        DeallocateSegment(new_data, segment);
+        return data;
+    }
+
+    void DeallocateSegment(T* data, size_t segment) noexcept
+    {
+        AllocTraits::deallocate(alloc_, data, AllocationSize(segment));
+    }
+
+    Alloc alloc_;
+    std::atomic<size_t> size_{ 0 };
+    std::atomic<T*> segments_[Layout::SEGMENT_COUNT] = {};
+};
@@ -0,0 +1,309 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+// Вектор с копированием при записи (copy-on-write) для снимков, которые копируют много читателей и
+// почти никогда не изменяют. Элементы хранятся в блоке со счётчиком ссылок: копирование CowVector
+// увеличивает счётчик за O(1), а буфер копируется только при первом изменении разделяемой копии.
+// Разные CowVector, разделяющие блок, можно использовать из разных потоков, как копии std::shared_ptr;
+// один и тот же CowVector требует внешней синхронизации.
+// Неконстантные operator[], begin и end считаются изменением и отделяют копию: читателям следует
+// обращаться к вектору через константную ссылку или cbegin/cend.
+template <typename T, typename Alloc = std::allocator<T>>
+class CowVector
+{
+    using Items = Vector<T, Alloc>;
+
+    struct Block
+    {
+        explicit Block(Items&& other) noexcept : items(std::move(other)) {}
+
+        std::atomic<size_t> ref_count{ 1 };
+        Items items;
+    };
+
+    using BlockAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Block>;
+    using BlockTraits = std::allocator_traits<BlockAlloc>;
+
+    // Ссылка на блок, освобождающая его при разрушении
+    struct BlockRef
+    {
+        explicit BlockRef(Block* other = nullptr) noexcept : block(other) {}
+
+        BlockRef(const BlockRef&) = delete;
+
+        BlockRef& operator=(const BlockRef&) = delete;
+
+        ~BlockRef()
+        {
+            Release(block);
+        }
+
+        Block* block = nullptr;
+    };
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using allocator_type = Alloc;
+
+    CowVector() = default;
+
+    explicit CowVector(const Alloc& alloc) noexcept : alloc_(alloc) {}
+
+    // Забирает элементы готового вектора: таблицу собирают в Vector и публикуют без копирования.
+    // Алгоритмическая сложность: O(1).
+    explicit CowVector(Items items) : alloc_(items.GetAllocator()), block_(NewBlock(std::move(items))) {}
+
+    // Копия разделяет буфер с other.
+    // Алгоритмическая сложность: O(1).
+    CowVector(const CowVector& other) noexcept : alloc_(other.alloc_), block_(other.block_)
+    {
+        if (block_ != nullptr)
+        {
+            block_->ref_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowVector(CowVector&& other) noexcept : alloc_(other.alloc_), block_(std::exchange(other.block_, nullptr)) {}
+
+    ~CowVector()
+    {
+        Release(block_);
+    }
+
+    CowVector& operator=(const CowVector& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            CowVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    CowVector& operator=(CowVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            CowVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    void Swap(CowVector& other) noexcept
+    {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+        std::swap(block_, other.block_);
+    }
+
+    // Число CowVector, разделяющих буфер (0, если буфер не создан)
+    size_t UseCount() const noexcept
+    {
+        return block_ != nullptr ? block_->ref_count.load(std::memory_order_relaxed) : 0;
+    }
+
+    size_t Size() const noexcept
+    {
+        return block_ != nullptr ? block_->items.Size() : 0;
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return block_ != nullptr ? block_->items.Capacity() : 0;
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        assert(index < Size());
+        return block_->items[index];
+    }
+
+    // Отделяет копию, если буфер разделяемый
+    T& operator[](size_t index)
+    {
+        assert(index < Size());
+        return MutableItems(Size())[index];
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return block_ != nullptr ? block_->items.begin() : nullptr;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return block_ != nullptr ? block_->items.end() : nullptr;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    // Отделяет копию, если буфер разделяемый
+    iterator begin()
+    {
+        return block_ != nullptr ? MutableItems(Size()).begin() : nullptr;
+    }
+
+    iterator end()
+    {
+        return block_ != nullptr ? MutableItems(Size()).end() : nullptr;
+    }
+
+    // Резервирует память под new_capacity элементов. Разделяемый буфер копируется сразу в буфер нужной вместимости.
+    // Алгоритмическая сложность: O(размер вектора).
+    void Reserve(size_t new_capacity)
+    {
+        MutableItems(new_capacity).Reserve(new_capacity);
+    }
+
+    void Resize(size_t new_size)
+    {
+        MutableItems(new_size).Resize(new_size);
+    }
+
+    void PushBack(const T& value)
+    {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value)
+    {
+        EmplaceBack(std::move(value));
+    }
+
+    // Добавляет элемент в конец вектора. Разделяемый буфер копируется с запасом под новый элемент.
+    // Алгоритмическая сложность: амортизированная O(1) для неразделяемого буфера, O(размер вектора) - для разделяемого.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        // Аргументы могут ссылаться на элементы разделяемого буфера: он освобождается после вставки
+        const BlockRef previous{ Detach(Size() + 1) };
+        return block_->items.EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    T& Insert(size_t index, const T& value)
+    {
+        return Emplace(index, value);
+    }
+
+    T& Insert(size_t index, T&& value)
+    {
+        return Emplace(index, std::move(value));
+    }
+
+    // Вставляет элемент в позицию index. Позиция задаётся индексом: итераторы на разделяемый буфер
+    // становятся недействительными при отделении копии.
+    // Алгоритмическая сложность: O(размер вектора).
+    template <typename... Args>
+    T& Emplace(size_t index, Args&&... args)
+    {
+        assert(index <= Size());
+        const BlockRef previous{ Detach(Size() + 1) };
+        return *block_->items.Emplace(block_->items.begin() + index, std::forward<Args>(args)...);
+    }
+
+    // Пустой вектор не изменяется и не отделяет копию
+    void PopBack()
+    {
+        if (Size() > 0)
+        {
+            MutableItems(Size()).PopBack();
+        }
+    }
+
+    void Erase(size_t index)
+    {
+        Erase(index, index + 1);
+    }
+
+    // Удаляет элементы [first, last).
+    // Алгоритмическая сложность: O(размер вектора).
+    void Erase(size_t first, size_t last)
+    {
+        assert(first <= last && last <= Size());
+        Items& items = MutableItems(Size());
+        items.Erase(items.begin() + first, items.begin() + last);
+    }
+
+    // Разделяемый буфер не копируется: вектор просто перестаёт на него ссылаться
+    void Clear() noexcept
+    {
+        if (IsShared())
+        {
+            Release(std::exchange(block_, nullptr));
+        }
+        else if (block_ != nullptr)
+        {
+            block_->items.Clear();
+        }
+    }
+
+    Alloc GetAllocator() const noexcept
+    {
+        return alloc_;
+    }
+
+private:
+    static Block* NewBlock(Items&& items)
+    {
+        BlockAlloc alloc(items.GetAllocator());
+        Block* block = BlockTraits::allocate(alloc, 1);
+        BlockTraits::construct(alloc, block, std::move(items));
+        return block;
+    }
+
+    static void Release(Block* block) noexcept
+    {
+        // acq_rel: разрушающий блок поток видит все изменения, сделанные до отделения других копий
+        if (block != nullptr && block->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            BlockAlloc alloc(block->items.GetAllocator());
+            BlockTraits::destroy(alloc, block);
+            BlockTraits::deallocate(alloc, block, 1);
+        }
+    }
+
+    bool IsShared() const noexcept
+    {
+        // acquire: изменения начинаются после того, как другие владельцы отпустили буфер
+        return block_ != nullptr && block_->ref_count.load(std::memory_order_acquire) != 1;
+    }
+
+    Items& MutableItems(size_t min_capacity)
+    {
+        const BlockRef previous{ Detach(min_capacity) };
+        return block_->items;
+    }
+
+    // Делает буфер собственным: разделяемые элементы копируются в новый блок вместимостью не меньше min_capacity.
+    // Возвращает прежний блок, который вызывающий отпускает после операции.
+    // Если копирование выбросит исключение, вектор не изменится
+    BlockRef Detach(size_t min_capacity)
+    {
+        if (block_ != nullptr && !IsShared())
+        {
+            return BlockRef{};
+        }
+        Items items(alloc_);
+        items.Reserve(std::max(min_capacity, Size()));
+        if (block_ != nullptr)
+        {
+            items.Insert(items.end(), block_->items.begin(), block_->items.end());
+        }
+        return BlockRef{ std::exchange(block_, NewBlock(std::move(items))) };
+    }
+
+    Alloc alloc_;
+    Block* block_ = nullptr;
+};
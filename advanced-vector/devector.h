@@ -0,0 +1,534 @@
+#pragma once
+#include "vector.h"
+
+// Двусторонний вектор: свободная память буфера RawMemory есть и перед элементами, и после них,
+// поэтому PushFront/PopFront выполняются за амортизированную O(1), как PushBack/PopBack.
+// Элементы лежат непрерывно, итераторы - указатели.
+// Если у нужного края места нет, а буфер заполнен не больше чем наполовину, элементы сдвигаются
+// к середине буфера без выделения памяти; иначе буфер растёт, и большая часть нового запаса
+// отдаётся краю, у которого не хватило места.
+// Вставка и удаление в середине сдвигают меньшую из частей по обе стороны от позиции.
+template <typename T, typename Alloc = std::allocator<T>>
+class DeVector
+{
+    // Сдвиг всех элементов внутри буфера не выбрасывает исключений
+    static constexpr bool NOTHROW_RELOCATE = IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using allocator_type = Alloc;
+
+    DeVector() = default;
+
+    explicit DeVector(const Alloc& alloc) noexcept : data_(alloc) {}
+
+    // Копия создаётся без запаса вместимости.
+    // Алгоритмическая сложность: O(размер исходного вектора).
+    DeVector(const DeVector& other)
+        : data_(other.size_, std::allocator_traits<Alloc>::select_on_container_copy_construction(other.data_.GetAllocator()))
+    {
+        std::uninitialized_copy_n(other.begin(), other.size_, data_.GetAddress());
+        size_ = other.size_;
+    }
+
+    DeVector(DeVector&& other) noexcept
+        : data_(std::move(other.data_))
+        , begin_(std::exchange(other.begin_, 0))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    ~DeVector()
+    {
+        std::destroy_n(begin(), size_);
+    }
+
+    // Копия строится отдельно и обменивается с текущим содержимым (строгая гарантия безопасности исключений)
+    DeVector& operator=(const DeVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            DeVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    DeVector& operator=(DeVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            DeVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    void Swap(DeVector& other) noexcept
+    {
+        data_.Swap(other.data_);
+        std::swap(begin_, other.begin_);
+        std::swap(size_, other.size_);
+    }
+
+    // Резервирует память под new_capacity элементов. Свободное место перед элементами сохраняется,
+    // весь добавленный запас оказывается после них.
+    // Алгоритмическая сложность: O(размер вектора).
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity <= data_.Capacity())
+        {
+            return;
+        }
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        Transfer(begin(), size_, new_data + begin_);
+        if constexpr (!IsTriviallyRelocatableV<T>)
+        {
+            std::destroy_n(begin(), size_);
+        }
+        data_.Swap(new_data);
+    }
+
+    void PushFront(const T& value)
+    {
+        EmplaceFront(value);
+    }
+
+    void PushFront(T&& value)
+    {
+        EmplaceFront(std::move(value));
+    }
+
+    // Добавляет элемент в начало вектора.
+    // Алгоритмическая сложность: амортизированная O(1).
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args)
+    {
+        if (begin_ == 0)
+        {
+            if (!CanRecenter())
+            {
+                return *EmplaceReallocate(0, std::forward<Args>(args)...);
+            }
+            // Аргументы могут ссылаться на элементы, которые сдвинутся к середине буфера
+            T temp(std::forward<Args>(args)...);
+            Recenter();
+            return ConstructFront(std::move(temp));
+        }
+        return ConstructFront(std::forward<Args>(args)...);
+    }
+
+    void PushBack(const T& value)
+    {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value)
+    {
+        EmplaceBack(std::move(value));
+    }
+
+    // Добавляет элемент в конец вектора.
+    // Алгоритмическая сложность: амортизированная O(1).
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        if (FreeBack() == 0)
+        {
+            if (!CanRecenter())
+            {
+                return *EmplaceReallocate(size_, std::forward<Args>(args)...);
+            }
+            T temp(std::forward<Args>(args)...);
+            Recenter();
+            return ConstructBack(std::move(temp));
+        }
+        return ConstructBack(std::forward<Args>(args)...);
+    }
+
+    void PopFront() noexcept
+    {
+        if (size_ > 0)
+        {
+            std::destroy_at(begin());
+            ++begin_;
+            --size_;
+            ResetIfEmpty();
+        }
+    }
+
+    void PopBack() noexcept
+    {
+        if (size_ > 0)
+        {
+            std::destroy_at(end() - 1);
+            --size_;
+            ResetIfEmpty();
+        }
+    }
+
+    iterator Insert(const_iterator pos, const T& value)
+    {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value)
+    {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Вставляет элемент перед pos, сдвигая меньшую из частей вектора по обе стороны от pos.
+    // Алгоритмическая сложность: O(min(pos - begin(), end() - pos)), если не требуется реаллокация.
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args)
+    {
+        assert(pos >= begin() && pos <= end());
+        const size_t index = pos - begin();
+        if (index == 0)
+        {
+            return &EmplaceFront(std::forward<Args>(args)...);
+        }
+        if (index == size_)
+        {
+            return &EmplaceBack(std::forward<Args>(args)...);
+        }
+
+        const bool front_is_shorter = index < size_ - index;
+        if (begin_ > 0 && (front_is_shorter || FreeBack() == 0))
+        {
+            return EmplaceShiftingFront(index, std::forward<Args>(args)...);
+        }
+        if (FreeBack() > 0)
+        {
+            return EmplaceShiftingBack(index, std::forward<Args>(args)...);
+        }
+        return EmplaceReallocate(index, std::forward<Args>(args)...);
+    }
+
+    iterator Erase(const_iterator pos)
+    {
+        assert(pos >= begin() && pos < end());
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая меньшую из частей вектора по обе стороны от них.
+    // Возвращает итератор на элемент, следующий за удалёнными.
+    // Алгоритмическая сложность: O(min(first - begin(), end() - last) + (last - first)).
+    iterator Erase(const_iterator first, const_iterator last)
+    {
+        assert(first >= begin() && first <= last && last <= end());
+
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        if (count == 0)
+        {
+            return begin() + index;
+        }
+
+        T* dst_first = begin() + index;
+        T* dst_last = dst_first + count;
+        if (index < size_ - index - count)
+        {
+            // Начало вектора сдвигается вправо на место удалённых элементов
+            if constexpr (IsTriviallyRelocatableV<T>)
+            {
+                std::destroy_n(dst_first, count);
+                detail::RelocateOverlapping(begin(), index, begin() + count);
+            }
+            else
+            {
+                if constexpr (detail::PreferMoveV<T>)
+                {
+                    std::move_backward(begin(), dst_first, dst_last);
+                }
+                else
+                {
+                    std::copy_backward(begin(), dst_first, dst_last);
+                }
+                std::destroy_n(begin(), count);
+            }
+            begin_ += count;
+        }
+        else
+        {
+            // Хвост сдвигается влево на место удалённых элементов
+            if constexpr (IsTriviallyRelocatableV<T>)
+            {
+                std::destroy_n(dst_first, count);
+                detail::RelocateOverlapping(dst_last, end() - dst_last, dst_first);
+            }
+            else
+            {
+                if constexpr (detail::PreferMoveV<T>)
+                {
+                    std::move(dst_last, end(), dst_first);
+                }
+                else
+                {
+                    std::copy(dst_last, end(), dst_first);
+                }
+                std::destroy_n(end() - count, count);
+            }
+        }
+        size_ -= count;
+        ResetIfEmpty();
+        return begin() + index;
+    }
+
+    void Clear() noexcept
+    {
+        std::destroy_n(begin(), size_);
+        size_ = 0;
+        ResetIfEmpty();
+    }
+
+    iterator begin() noexcept
+    {
+        return data_ + begin_;
+    }
+
+    iterator end() noexcept
+    {
+        return begin() + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data_ + begin_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return begin() + size_;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return data_.Capacity();
+    }
+
+    // Число элементов, которые можно добавить в начало без сдвига и реаллокации
+    size_t FreeFront() const noexcept
+    {
+        return begin_;
+    }
+
+    // Число элементов, которые можно добавить в конец без сдвига и реаллокации
+    size_t FreeBack() const noexcept
+    {
+        return data_.Capacity() - begin_ - size_;
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        return const_cast<DeVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        return data_[begin_ + index];
+    }
+
+    Alloc GetAllocator() const noexcept
+    {
+        return data_.GetAllocator();
+    }
+
+private:
+    template <typename... Args>
+    T& ConstructFront(Args&&... args)
+    {
+        T* element = new (begin() - 1) T(std::forward<Args>(args)...);
+        --begin_;
+        ++size_;
+        return *element;
+    }
+
+    template <typename... Args>
+    T& ConstructBack(Args&&... args)
+    {
+        T* element = new (end()) T(std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    // Сдвиг к середине окупается, если после него у каждого края останется не меньше четверти буфера:
+    // до следующего сдвига успеет пройти не меньше операций, чем элементов переносит этот
+    bool CanRecenter() const noexcept
+    {
+        return NOTHROW_RELOCATE && size_ < data_.Capacity() / 2;
+    }
+
+    // Сдвигает элементы внутри буфера так, чтобы свободное место поровну разделилось между краями
+    void Recenter() noexcept
+    {
+        const size_t new_begin = (data_.Capacity() - size_) / 2;
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::RelocateOverlapping(begin(), size_, data_ + new_begin);
+        }
+        else if constexpr (NOTHROW_RELOCATE)
+        {
+            // Порядок обхода гарантирует, что целевая ячейка уже освобождена или лежала вне элементов
+            if (new_begin < begin_)
+            {
+                for (size_t i = 0; i < size_; ++i)
+                {
+                    new (data_ + new_begin + i) T(std::move(data_[begin_ + i]));
+                    std::destroy_at(data_ + begin_ + i);
+                }
+            }
+            else
+            {
+                for (size_t i = size_; i > 0; --i)
+                {
+                    new (data_ + new_begin + i - 1) T(std::move(data_[begin_ + i - 1]));
+                    std::destroy_at(data_ + begin_ + i - 1);
+                }
+            }
+        }
+        begin_ = new_begin;
+    }
+
+    // Пустой вектор начинает с середины буфера, чтобы одинаково расти в обе стороны
+    void ResetIfEmpty() noexcept
+    {
+        if (size_ == 0)
+        {
+            begin_ = data_.Capacity() / 2;
+        }
+    }
+
+    template <typename... Args>
+    iterator EmplaceShiftingFront(size_t index, Args&&... args)
+    {
+        T* first = begin();
+        T* pos = first + index;
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            // Временный объект создаётся в сырой памяти, чтобы затем перенести его в вектор без перемещения
+            alignas(T) unsigned char storage[sizeof(T)];
+            T* temp = new (storage) T(std::forward<Args>(args)...);
+            detail::RelocateOverlapping(first, index, first - 1);
+            detail::Relocate(temp, 1, pos - 1);
+        }
+        else
+        {
+            T temp(std::forward<Args>(args)...);
+            new (first - 1) T(std::move(*first));
+            std::move(first + 1, pos, first);
+            *(pos - 1) = std::move(temp);
+        }
+        --begin_;
+        ++size_;
+        return pos - 1;
+    }
+
+    template <typename... Args>
+    iterator EmplaceShiftingBack(size_t index, Args&&... args)
+    {
+        T* pos = begin() + index;
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            alignas(T) unsigned char storage[sizeof(T)];
+            T* temp = new (storage) T(std::forward<Args>(args)...);
+            detail::RelocateOverlapping(pos, size_ - index, pos + 1);
+            detail::Relocate(temp, 1, pos);
+        }
+        else
+        {
+            T temp(std::forward<Args>(args)...);
+            new (end()) T(std::move(*(end() - 1)));
+            std::move_backward(pos, end() - 1, end());
+            *pos = std::move(temp);
+        }
+        ++size_;
+        return pos;
+    }
+
+    // Выделяет буфер большей вместимости и создаёт в нём элемент index.
+    // Запас нового буфера достаётся краю, у которого не хватило места; при вставке в середину делится поровну
+    template <typename... Args>
+    iterator EmplaceReallocate(size_t index, Args&&... args)
+    {
+        const size_t new_capacity = std::max(DoublingGrowth::NextCapacity(data_.Capacity(), sizeof(T)), size_ + 1);
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        const size_t free = new_data.Capacity() - size_ - 1;
+        size_t new_begin = free / 2;
+        if (index == 0)
+        {
+            new_begin = free - std::min(FreeBack(), free / 4);
+        }
+        else if (index == size_)
+        {
+            new_begin = std::min(begin_, free / 4);
+        }
+
+        T* new_first = new_data + new_begin;
+        // Элемент создаётся до переноса: аргументы могут ссылаться на элементы текущего буфера
+        T* element = new (new_first + index) T(std::forward<Args>(args)...);
+        try
+        {
+            Transfer(begin(), index, new_first);
+            try
+            {
+                Transfer(begin() + index, size_ - index, new_first + index + 1);
+            }
+            catch (...)
+            {
+                std::destroy_n(new_first, index);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            std::destroy_at(element);
+            throw;
+        }
+        if constexpr (!IsTriviallyRelocatableV<T>)
+        {
+            std::destroy_n(begin(), size_);
+        }
+        data_.Swap(new_data);
+        begin_ = new_begin;
+        ++size_;
+        return element;
+    }
+
+    // Переносит count элементов в неинициализированную память result. Тривиально перемещаемые элементы
+    // переносятся побайтово, остальные перемещаются или копируются согласно PreferMoveV;
+    // исходные элементы в этом случае разрушает вызывающий
+    static void Transfer(T* first, size_t count, T* result)
+    {
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::Relocate(first, count, result);
+        }
+        else
+        {
+            detail::UninitializedCopyOrMove(first, count, result);
+        }
+    }
+
+    RawMemory<T, Alloc> data_;
+    // Индекс первого элемента в буфере
+    size_t begin_ = 0;
+    size_t size_ = 0;
+};
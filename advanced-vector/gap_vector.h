@@ -0,0 +1,588 @@
+#pragma once
+#include "vector.h"
+
+#include <stdexcept>
+
+// Вектор с разрывом (gap buffer) для серий вставок и удалений около одной позиции.
+// Свободная часть буфера хранится не в конце, а в разрыве: элементы [0, GapPosition()) лежат в начале буфера,
+// остальные - в его конце. Вставка и удаление в позиции разрыва не сдвигают элементы, а перенос разрыва
+// на расстояние d перемещает d элементов. Поэтому серия правок около курсора стоит O(1) на операцию,
+// а не O(размер вектора), как сдвиг хвоста в Vector.
+// Доступ по индексу - O(1). Итераторы обходят элементы по индексу, минуя разрыв, и не переносят его;
+// непрерывный участок (Data) получается переносом разрыва в конец.
+// После удаления последнего элемента (PopBack), когда разрыв не в конце, освободившийся слот остаётся
+// за элементами в конце буфера и присоединяется к разрыву, как только за разрывом не останется элементов.
+// Ссылки на элементы становятся недействительными при переносе разрыва через них и при росте.
+template <typename T, typename Alloc = std::allocator<T>>
+class GapVector
+{
+    // Итератор произвольного доступа: хранит вектор и индекс элемента и обходит элементы, минуя разрыв.
+    // Разрыв не переносится, поэтому итератор по индексу остаётся на том же элементе при правках справа от него
+    template <typename Value>
+    class Iterator
+    {
+        using Container = std::conditional_t<std::is_const_v<Value>, const GapVector, GapVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        Iterator() = default;
+
+        Iterator(Container* vector, size_t index) noexcept : vector_(vector), index_(index) {}
+
+        // Преобразование iterator в const_iterator
+        template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Value>>>
+        Iterator(const Iterator<Other>& other) noexcept : vector_(other.vector_), index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return (*vector_)[index_];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &(*vector_)[index_];
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return (*vector_)[index_ + n];
+        }
+
+        Iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        Iterator& operator--() noexcept
+        {
+            --index_;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept
+        {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+
+        Iterator& operator+=(difference_type n) noexcept
+        {
+            index_ += n;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n) noexcept
+        {
+            index_ -= n;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ >= rhs.index_;
+        }
+
+        size_t Index() const noexcept
+        {
+            return index_;
+        }
+
+    private:
+        template <typename>
+        friend class Iterator;
+
+        Container* vector_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+    using allocator_type = Alloc;
+
+    GapVector() = default;
+
+    explicit GapVector(const Alloc& alloc) noexcept : data_(alloc) {}
+
+    // Копия создаётся без разрыва и без запаса вместимости.
+    // Алгоритмическая сложность: O(размер исходного вектора).
+    GapVector(const GapVector& other)
+        : data_(other.Size(), std::allocator_traits<Alloc>::select_on_container_copy_construction(other.data_.GetAllocator()))
+    {
+        const size_t split = other.gap_begin_;
+        std::uninitialized_copy_n(other.data_.GetAddress(), split, data_.GetAddress());
+        try
+        {
+            std::uninitialized_copy_n(other.data_ + other.gap_end_, other.Size() - split, data_ + split);
+        }
+        catch (...)
+        {
+            std::destroy_n(data_.GetAddress(), split);
+            throw;
+        }
+        gap_begin_ = other.Size();
+        gap_end_ = end_ = data_.Capacity();
+    }
+
+    GapVector(GapVector&& other) noexcept
+        : data_(std::move(other.data_))
+        , gap_begin_(std::exchange(other.gap_begin_, 0))
+        , gap_end_(std::exchange(other.gap_end_, 0))
+        , end_(std::exchange(other.end_, 0))
+    {
+    }
+
+    ~GapVector()
+    {
+        DestroyAll();
+    }
+
+    // Копия строится отдельно и обменивается с текущим содержимым (строгая гарантия безопасности исключений)
+    GapVector& operator=(const GapVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            GapVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    GapVector& operator=(GapVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            GapVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    void Swap(GapVector& other) noexcept
+    {
+        data_.Swap(other.data_);
+        std::swap(gap_begin_, other.gap_begin_);
+        std::swap(gap_end_, other.gap_end_);
+        std::swap(end_, other.end_);
+    }
+
+    // Резервирует память под new_capacity элементов. Разрыв остаётся на месте и увеличивается.
+    // Алгоритмическая сложность: O(размер вектора).
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity <= data_.Capacity())
+        {
+            return;
+        }
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        TransferTo(new_data, gap_begin_);
+    }
+
+    // Переносит разрыв в позицию index, перемещая элементы между прежней и новой позицией.
+    // Если перемещение элемента выбросит исключение, порядок элементов не нарушается: разрыв
+    // остаётся в промежуточной позиции.
+    // Алгоритмическая сложность: O(|index - GapPosition()|).
+    void MoveGap(size_t index)
+    {
+        assert(index <= Size());
+        if (GapSize() == 0)
+        {
+            // Без разрыва элементы лежат непрерывно, и физические позиции совпадают с логическими
+            // при любом его положении. Свободные слоты за элементами становятся разрывом в конце
+            gap_begin_ = gap_end_ = end_;
+            AbsorbFreeTail();
+            if (GapSize() == 0)
+            {
+                gap_begin_ = gap_end_ = index;
+                return;
+            }
+        }
+
+        const size_t gap = GapSize();
+
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            if (index < gap_begin_)
+            {
+                detail::RelocateOverlapping(data_ + index, gap_begin_ - index, data_ + index + gap);
+            }
+            else
+            {
+                detail::RelocateOverlapping(data_ + gap_end_, index - gap_begin_, data_ + gap_begin_);
+            }
+            gap_begin_ = index;
+            gap_end_ = index + gap;
+        }
+        else
+        {
+            // Элементы переходят через разрыв по одному, и после каждого шага вектор согласован
+            for (; gap_begin_ > index; --gap_begin_, --gap_end_)
+            {
+                new (data_ + gap_end_ - 1) T(detail::MoveOrCopy(data_[gap_begin_ - 1]));
+                std::destroy_at(data_ + gap_begin_ - 1);
+            }
+            for (; gap_begin_ < index; ++gap_begin_, ++gap_end_)
+            {
+                new (data_ + gap_begin_) T(detail::MoveOrCopy(data_[gap_end_]));
+                std::destroy_at(data_ + gap_end_);
+            }
+        }
+        AbsorbFreeTail();
+    }
+
+    void PushBack(const T& value)
+    {
+        Emplace(Size(), value);
+    }
+
+    void PushBack(T&& value)
+    {
+        Emplace(Size(), std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        return Emplace(Size(), std::forward<Args>(args)...);
+    }
+
+    T& Insert(size_t index, const T& value)
+    {
+        return Emplace(index, value);
+    }
+
+    T& Insert(size_t index, T&& value)
+    {
+        return Emplace(index, std::move(value));
+    }
+
+    // Вставляет элемент в позицию index, перенося туда разрыв. После вставки разрыв стоит сразу за
+    // новым элементом, поэтому следующая вставка в index + 1 не перемещает элементов.
+    // Если конструктор элемента выбросит исключение, элементы вектора не изменятся.
+    // Алгоритмическая сложность: O(|index - GapPosition()|), амортизированная O(1) для вставки в позицию разрыва.
+    template <typename... Args>
+    T& Emplace(size_t index, Args&&... args)
+    {
+        assert(index <= Size());
+        if (Size() == data_.Capacity())
+        {
+            return EmplaceReallocate(index, std::forward<Args>(args)...);
+        }
+        if (index != gap_begin_ || GapSize() == 0)
+        {
+            // Аргументы могут ссылаться на элементы, которые переместит перенос разрыва
+            T temp(std::forward<Args>(args)...);
+            MoveGap(index);
+            return ConstructAtGap(std::move(temp));
+        }
+        return ConstructAtGap(std::forward<Args>(args)...);
+    }
+
+    // Удаляет элемент index.
+    // Алгоритмическая сложность: O(|index - GapPosition()|), O(1) для элементов по обе стороны разрыва.
+    void Erase(size_t index)
+    {
+        Erase(index, index + 1);
+    }
+
+    // Удаляет элементы [first, last). Разрыв поглощает удалённые элементы.
+    // Алгоритмическая сложность: O(|first - GapPosition()| + (last - first)).
+    void Erase(size_t first, size_t last)
+    {
+        assert(first <= last && last <= Size());
+        if (last == gap_begin_)
+        {
+            // Удаляемые элементы примыкают к разрыву слева
+            std::destroy_n(data_ + first, last - first);
+            gap_begin_ = first;
+            return;
+        }
+        MoveGap(first);
+        std::destroy_n(data_ + gap_end_, last - first);
+        gap_end_ += last - first;
+        AbsorbFreeTail();
+    }
+
+    // Удаляет последний элемент на месте, не перенося разрыв.
+    // Алгоритмическая сложность: O(1).
+    void PopBack() noexcept
+    {
+        if (Size() == 0)
+        {
+            return;
+        }
+        if (gap_end_ == end_)
+        {
+            std::destroy_at(data_ + --gap_begin_);
+        }
+        else
+        {
+            std::destroy_at(data_ + --end_);
+            AbsorbFreeTail();
+        }
+    }
+
+    void Clear() noexcept
+    {
+        DestroyAll();
+        gap_begin_ = 0;
+        gap_end_ = end_ = data_.Capacity();
+    }
+
+    // Переносит разрыв в конец и возвращает указатель на непрерывные элементы.
+    // Алгоритмическая сложность: O(Size() - GapPosition()).
+    T* Data()
+    {
+        MoveGap(Size());
+        return data_.GetAddress();
+    }
+
+    // Непрерывные элементы константного вектора. Константный вектор не может перенести разрыв,
+    // поэтому, если элементы не лежат непрерывно, выбрасывается std::logic_error: используйте begin()/end() или operator[]
+    const T* Data() const
+    {
+        if (gap_begin_ != Size() && GapSize() != 0)
+        {
+            throw std::logic_error("GapVector: elements are not contiguous, call MoveGap(Size()) first");
+        }
+        return data_.GetAddress();
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(this, Size());
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(this, Size());
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    size_t GapPosition() const noexcept
+    {
+        return gap_begin_;
+    }
+
+    size_t GapSize() const noexcept
+    {
+        return gap_end_ - gap_begin_;
+    }
+
+    size_t Size() const noexcept
+    {
+        return gap_begin_ + (end_ - gap_end_);
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return data_.Capacity();
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        assert(index < Size());
+        return data_[PhysicalIndex(index)];
+    }
+
+    T& operator[](size_t index) noexcept
+    {
+        assert(index < Size());
+        return data_[PhysicalIndex(index)];
+    }
+
+    Alloc GetAllocator() const noexcept
+    {
+        return data_.GetAllocator();
+    }
+
+private:
+    // Если за разрывом не осталось элементов, свободные слоты в конце буфера присоединяются к разрыву
+    void AbsorbFreeTail() noexcept
+    {
+        if (gap_end_ == end_)
+        {
+            gap_end_ = end_ = data_.Capacity();
+        }
+    }
+
+    // Положение элемента index в буфере: элементы за разрывом смещены на его размер
+    size_t PhysicalIndex(size_t index) const noexcept
+    {
+        return index < gap_begin_ ? index : index + GapSize();
+    }
+
+    template <typename... Args>
+    T& ConstructAtGap(Args&&... args)
+    {
+        T* element = new (data_ + gap_begin_) T(std::forward<Args>(args)...);
+        ++gap_begin_;
+        return *element;
+    }
+
+    template <typename... Args>
+    T& EmplaceReallocate(size_t index, Args&&... args)
+    {
+        const size_t new_capacity = std::max(DoublingGrowth::NextCapacity(data_.Capacity(), sizeof(T)), Size() + 1);
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        // Элемент создаётся до переноса: аргументы могут ссылаться на элементы текущего буфера
+        T* element = new (new_data + index) T(std::forward<Args>(args)...);
+        try
+        {
+            TransferTo(new_data, index);
+        }
+        catch (...)
+        {
+            std::destroy_at(element);
+            throw;
+        }
+        ++gap_begin_;
+        return *element;
+    }
+
+    // Переносит элементы в new_data: [0, index) - в начало буфера, [index, Size()) - в его конец,
+    // и делает new_data текущим буфером с разрывом в позиции index.
+    // Если перенос выбросит исключение, текущий буфер не изменяется
+    void TransferTo(RawMemory<T, Alloc>& new_data, size_t index)
+    {
+        const size_t size = Size();
+        const size_t new_gap_end = new_data.Capacity() - (size - index);
+        TransferRange(0, index, new_data.GetAddress());
+        try
+        {
+            TransferRange(index, size, new_data + new_gap_end);
+        }
+        catch (...)
+        {
+            std::destroy_n(new_data.GetAddress(), index);
+            throw;
+        }
+        if constexpr (!IsTriviallyRelocatableV<T>)
+        {
+            DestroyAll();
+        }
+        data_.Swap(new_data);
+        gap_begin_ = index;
+        gap_end_ = new_gap_end;
+        end_ = data_.Capacity();
+    }
+
+    // Переносит элементы с индексами [first, last) в неинициализированную память result.
+    // Тривиально перемещаемые элементы переносятся побайтово, остальные перемещаются или копируются
+    // согласно PreferMoveV; исходные элементы в этом случае разрушает вызывающий
+    void TransferRange(size_t first, size_t last, T* result)
+    {
+        const size_t split = std::clamp(gap_begin_, first, last);
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::Relocate(data_ + first, split - first, result);
+            detail::Relocate(data_ + split + GapSize(), last - split, result + (split - first));
+        }
+        else
+        {
+            detail::UninitializedCopyOrMove(data_ + first, split - first, result);
+            try
+            {
+                detail::UninitializedCopyOrMove(data_ + split + GapSize(), last - split, result + (split - first));
+            }
+            catch (...)
+            {
+                std::destroy_n(result, split - first);
+                throw;
+            }
+        }
+    }
+
+    void DestroyAll() noexcept
+    {
+        std::destroy_n(data_.GetAddress(), gap_begin_);
+        std::destroy_n(data_ + gap_end_, end_ - gap_end_);
+    }
+
+    RawMemory<T, Alloc> data_;
+    // Разрыв - неинициализированные слоты [gap_begin_, gap_end_), элементы за ним - [gap_end_, end_).
+    // Слоты [end_, Capacity()) свободны только при непустом [gap_end_, end_)
+    size_t gap_begin_ = 0;
+    size_t gap_end_ = 0;
+    size_t end_ = 0;
+};
@@ -0,0 +1,304 @@
+#pragma once
+#include "vector.h"
+
+// Вектор с постепенным (деамортизированным) переносом элементов при росте.
+// Когда вектор заполнен, PushBack выделяет буфер вдвое большей вместимости и создаёт в нём новый элемент,
+// но не переносит имеющиеся: прежний буфер сохраняется, а элементы переносятся из него в новый
+// не более чем по MigrationStep за каждый последующий PushBack/EmplaceBack.
+// Пока новый буфер заполняется до конца, перенос гарантированно завершается, поэтому каждая операция
+// выполняет O(1) работы в худшем случае (не считая выделения памяти).
+// Во время переноса элементы [migrated, old_size) лежат в прежнем буфере, остальные - в новом.
+// Непрерывность восстанавливается после завершения переноса. Итераторы (begin()/end()) есть только
+// у неконстантного вектора: они сначала завершают перенос за O(n) (FinishMigration). Константный вектор
+// перенос завершить не может и обходится по индексу через operator[].
+// Ссылки на элементы, ещё не перенесённые из прежнего буфера, становятся недействительными при их переносе,
+// то есть только при PushBack/EmplaceBack, Reserve, FinishMigration и begin()/end(); operator[] элементы не переносит.
+template <typename T, typename Alloc = std::allocator<T>, size_t MigrationStep = 2>
+class IncrementalVector
+{
+    static_assert(MigrationStep > 0, "Migration must make progress on every append");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using allocator_type = Alloc;
+
+    IncrementalVector() = default;
+
+    explicit IncrementalVector(const Alloc& alloc) noexcept : data_(alloc), old_(alloc) {}
+
+    // Копия создаётся в одном непрерывном буфере.
+    // Алгоритмическая сложность: O(размер исходного вектора).
+    IncrementalVector(const IncrementalVector& other)
+        : data_(other.size_, std::allocator_traits<Alloc>::select_on_container_copy_construction(other.data_.GetAllocator()))
+        , old_(data_.GetAllocator())
+    {
+        T* dst = data_.GetAddress();
+        size_t copied = 0;
+        try
+        {
+            for (; copied < other.size_; ++copied)
+            {
+                new (dst + copied) T(other[copied]);
+            }
+        }
+        catch (...)
+        {
+            std::destroy_n(dst, copied);
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    IncrementalVector(IncrementalVector&& other) noexcept
+        : data_(std::move(other.data_))
+        , old_(std::move(other.old_))
+        , size_(std::exchange(other.size_, 0))
+        , migrated_(std::exchange(other.migrated_, 0))
+        , old_size_(std::exchange(other.old_size_, 0))
+    {
+    }
+
+    ~IncrementalVector()
+    {
+        DestroyAll();
+    }
+
+    // Копия строится отдельно и обменивается с текущим содержимым (строгая гарантия безопасности исключений)
+    IncrementalVector& operator=(const IncrementalVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            IncrementalVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    IncrementalVector& operator=(IncrementalVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            IncrementalVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    void Swap(IncrementalVector& other) noexcept
+    {
+        data_.Swap(other.data_);
+        old_.Swap(other.old_);
+        std::swap(size_, other.size_);
+        std::swap(migrated_, other.migrated_);
+        std::swap(old_size_, other.old_size_);
+    }
+
+    void PushBack(const T& value)
+    {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value)
+    {
+        EmplaceBack(std::move(value));
+    }
+
+    // Добавляет элемент в конец вектора и переносит не более MigrationStep элементов из прежнего буфера.
+    // Если вектор заполнен, выделяется новый буфер, но элементы в него сразу не переносятся.
+    // Алгоритмическая сложность: O(MigrationStep) в худшем случае.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        T* element;
+        if (size_ == data_.Capacity())
+        {
+            // При удвоении вместимости перенос успевает завершиться раньше, чем новый буфер заполнится.
+            // Он может остаться незавершённым, только если перенос элементов выбрасывал исключения
+            FinishMigration();
+            RawMemory<T, Alloc> new_data(size_ == 0 ? 1 : size_ * 2, data_.GetAllocator());
+            // Аргументы могут ссылаться на элементы прежнего буфера, поэтому элемент создаётся до переключения
+            element = new (new_data + size_) T(std::forward<Args>(args)...);
+            old_.Swap(data_);
+            data_.Swap(new_data);
+            migrated_ = 0;
+            old_size_ = size_;
+        }
+        else
+        {
+            element = new (data_ + size_) T(std::forward<Args>(args)...);
+        }
+        ++size_;
+        MigrateNoThrow(MigrationStep);
+        return *element;
+    }
+
+    void PopBack() noexcept
+    {
+        if (size_ == 0)
+        {
+            return;
+        }
+        --size_;
+        std::destroy_at(Slot(size_));
+        if (size_ < old_size_)
+        {
+            // Удалён элемент, ещё не перенесённый из прежнего буфера
+            old_size_ = size_;
+            MigrateNoThrow(0);
+        }
+    }
+
+    void Clear() noexcept
+    {
+        while (size_ > 0)
+        {
+            PopBack();
+        }
+    }
+
+    // Резервирует память под new_capacity элементов. Незавершённый перенос завершается,
+    // после чего элементы переносятся в новый буфер сразу.
+    // Алгоритмическая сложность: O(размер вектора).
+    void Reserve(size_t new_capacity)
+    {
+        FinishMigration();
+        if (new_capacity <= data_.Capacity())
+        {
+            return;
+        }
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        Transfer(data_.GetAddress(), size_, new_data.GetAddress());
+        data_.Swap(new_data);
+    }
+
+    // Переносит все оставшиеся элементы из прежнего буфера и освобождает его
+    void FinishMigration()
+    {
+        Migrate(old_size_ - migrated_);
+    }
+
+    bool IsMigrating() const noexcept
+    {
+        return old_.GetAddress() != nullptr;
+    }
+
+    // Итераторы - указатели на элементы одного буфера: незавершённый перенос завершается.
+    // Константных итераторов нет: константный вектор обходится по индексу.
+    // Алгоритмическая сложность: O(1), если перенос не идёт, иначе O(размер вектора).
+    iterator begin()
+    {
+        FinishMigration();
+        return data_.GetAddress();
+    }
+
+    iterator end()
+    {
+        return begin() + size_;
+    }
+
+    size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return data_.Capacity();
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        assert(index < size_);
+        return *Slot(index);
+    }
+
+    // Доступ по индексу не переносит элементы: ссылки, полученные раньше, остаются действительными
+    T& operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        return *Slot(index);
+    }
+
+private:
+    T* Slot(size_t index) noexcept
+    {
+        return index >= migrated_ && index < old_size_ ? old_ + index : data_ + index;
+    }
+
+    const T* Slot(size_t index) const noexcept
+    {
+        return index >= migrated_ && index < old_size_ ? old_ + index : data_ + index;
+    }
+
+    // Переносит до count элементов из прежнего буфера. Если перенос завершён, прежний буфер освобождается.
+    // Если копирование элемента выбросит исключение, уже перенесённые элементы остаются в новом буфере
+    void Migrate(size_t count)
+    {
+        if (!IsMigrating())
+        {
+            return;
+        }
+        const size_t end = std::min(old_size_, migrated_ + count);
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::Relocate(old_ + migrated_, end - migrated_, data_ + migrated_);
+            migrated_ = end;
+        }
+        else
+        {
+            for (; migrated_ < end; ++migrated_)
+            {
+                new (data_ + migrated_) T(detail::MoveOrCopy(old_[migrated_]));
+                std::destroy_at(old_ + migrated_);
+            }
+        }
+        if (migrated_ == old_size_)
+        {
+            old_ = RawMemory<T, Alloc>(old_.GetAllocator());
+            migrated_ = 0;
+            old_size_ = 0;
+        }
+    }
+
+    // Элемент уже добавлен, поэтому исключение при переносе не передаётся дальше:
+    // перенос продолжится при следующих операциях
+    void MigrateNoThrow(size_t count) noexcept
+    {
+        try
+        {
+            Migrate(count);
+        }
+        catch (...)
+        {
+        }
+    }
+
+    static void Transfer(T* first, size_t count, T* result)
+    {
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::Relocate(first, count, result);
+        }
+        else
+        {
+            detail::UninitializedCopyOrMove(first, count, result);
+            std::destroy_n(first, count);
+        }
+    }
+
+    void DestroyAll() noexcept
+    {
+        for (size_t i = 0; i < size_; ++i)
+        {
+            std::destroy_at(Slot(i));
+        }
+    }
+
+    RawMemory<T, Alloc> data_;
+    // Прежний буфер, из которого ещё не перенесены элементы [migrated_, old_size_)
+    RawMemory<T, Alloc> old_;
+    size_t size_ = 0;
+    size_t migrated_ = 0;
+    size_t old_size_ = 0;
+};
@@ -1,9 +1,33 @@
 #include "vector.h"
+#include "small_vector.h"
+#include "mmap_allocator.h"
+#include "mapped_vector.h"
+#include "vector_io.h"
+#include "parallel_execution.h"
+#include "numa_allocator.h"
+#include "concurrent_vector.h"
+#include "segmented_vector.h"
+#include "incremental_vector.h"
+#include "soa_vector.h"
+#include "simd_algorithms.h"
+#include "aligned_allocator.h"
+#include "vector_stats.h"
+#include "gap_vector.h"
+#include "devector.h"
+#include "cow_vector.h"
 
+#include <atomic>
+#include <cmath>
+#include <deque>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
+#include <list>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <iterator>
 
 namespace
 {
@@ -125,8 +149,131 @@ namespace
         static inline int num_move_assigned = 0;
     };
 
+    // Аллокатор с состоянием: считает выделения и освобождения в общем счётчике "арены".
+    // Два аллокатора равны, если работают с одной и той же ареной
+    template <typename T, bool Propagate>
+    struct ArenaAllocator
+    {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+        using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+        using propagate_on_container_swap = std::bool_constant<Propagate>;
+
+        struct Arena
+        {
+            size_t allocations = 0;
+            size_t deallocations = 0;
+            size_t bytes_in_use = 0;
+        };
+
+        explicit ArenaAllocator(Arena* arena) noexcept : arena(arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U, Propagate>& other) noexcept : arena(other.arena) {}
+
+        template <typename U>
+        struct rebind
+        {
+            using other = ArenaAllocator<U, Propagate>;
+        };
+
+        T* allocate(size_t n)
+        {
+            ++arena->allocations;
+            arena->bytes_in_use += n * sizeof(T);
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t n) noexcept
+        {
+            ++arena->deallocations;
+            arena->bytes_in_use -= n * sizeof(T);
+            operator delete(p);
+        }
+
+        bool operator==(const ArenaAllocator& other) const noexcept
+        {
+            return arena == other.arena;
+        }
+
+        bool operator!=(const ArenaAllocator& other) const noexcept
+        {
+            return arena != other.arena;
+        }
+
+        Arena* arena;
+    };
+
+    // Тип с явно включённым признаком IsTriviallyRelocatable: владеет ресурсом,
+    // но не хранит указателей на себя, поэтому его можно переносить побайтово
+    struct RelocatableObj
+    {
+        explicit RelocatableObj(int id) : id(std::make_unique<int>(id)) {}
+
+        RelocatableObj(RelocatableObj&& other) noexcept : id(std::move(other.id))
+        {
+            ++num_moved;
+        }
+
+        RelocatableObj& operator=(RelocatableObj&& other) noexcept
+        {
+            id = std::move(other.id);
+            ++num_moved;
+            return *this;
+        }
+
+        ~RelocatableObj()
+        {
+            ++num_destroyed;
+        }
+
+        std::unique_ptr<int> id;
+
+        static inline int num_moved = 0;
+        static inline int num_destroyed = 0;
+    };
+
+
+    // Объект со счётчиками, безопасными для параллельных операций
+    struct AtomicCountedObj
+    {
+        AtomicCountedObj()
+        {
+            MaybeThrow();
+            ++num_alive;
+        }
+
+        AtomicCountedObj(const AtomicCountedObj& other) : id(other.id)
+        {
+            MaybeThrow();
+            ++num_alive;
+        }
+
+        AtomicCountedObj& operator=(const AtomicCountedObj& other) = default;
+
+        ~AtomicCountedObj()
+        {
+            --num_alive;
+        }
+
+        static void MaybeThrow()
+        {
+            if (throw_countdown.load() > 0 && throw_countdown.fetch_sub(1) == 1)
+            {
+                throw std::runtime_error("Oops");
+            }
+        }
+
+        int id = 0;
+
+        static inline std::atomic<int> num_alive = 0;
+        static inline std::atomic<int> throw_countdown = 0;
+    };
 }  // namespace
 
+template <>
+struct IsTriviallyRelocatable<RelocatableObj> : std::true_type {};
+
 void Test1()
 {
     Obj::ResetCounters();
@@ -589,101 +736,1945 @@ void Test6()
     }
 }
 
-struct C
+void Test7()
 {
-    C() noexcept
+    const size_t SIZE = 100;
+    const int ID = 42;
+    {
+        using Alloc = ArenaAllocator<Obj, false>;
+        Alloc::Arena arena;
+        Obj::ResetCounters();
+        {
+            Vector<Obj, Alloc> v(SIZE, Alloc(&arena));
+            v.PushBack(Obj{ ID });
+            assert(arena.allocations == 2);
+            assert(arena.deallocations == 1);
+            assert(arena.bytes_in_use == v.Capacity() * sizeof(Obj));
+
+            Vector<Obj, Alloc> v_copy(v);
+            assert(v_copy.GetAllocator() == v.GetAllocator());
+            assert(arena.allocations == 3);
+        }
+        assert(arena.allocations == arena.deallocations);
+        assert(arena.bytes_in_use == 0);
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
     {
-        ++def_ctor;
+        // Аллокатор не распространяется при перемещении: при разных аренах элементы перемещаются поштучно
+        using Alloc = ArenaAllocator<Obj, false>;
+        Alloc::Arena arena1;
+        Alloc::Arena arena2;
+        Obj::ResetCounters();
+        {
+            Vector<Obj, Alloc> v1(SIZE, Alloc(&arena1));
+            Vector<Obj, Alloc> v2{ Alloc(&arena2) };
+            v1[SIZE - 1].id = ID;
+            v2 = std::move(v1);
+            assert(v2.GetAllocator() == Alloc(&arena2));
+            assert(v2.Size() == SIZE);
+            assert(v2[SIZE - 1].id == ID);
+            assert(Obj::num_moved == SIZE);
+            assert(arena2.bytes_in_use == SIZE * sizeof(Obj));
+        }
+        assert(arena1.bytes_in_use == 0);
+        assert(arena2.bytes_in_use == 0);
+        assert(Obj::GetAliveObjectCount() == 0);
     }
-    C(const C& /*other*/) noexcept
     {
-        ++copy_ctor;
+        // Распространяемый аллокатор переезжает вместе с буфером
+        using Alloc = ArenaAllocator<Obj, true>;
+        Alloc::Arena arena1;
+        Alloc::Arena arena2;
+        Obj::ResetCounters();
+        {
+            Vector<Obj, Alloc> v1(SIZE, Alloc(&arena1));
+            Vector<Obj, Alloc> v2(SIZE / 2, Alloc(&arena2));
+            v1.Swap(v2);
+            assert(v1.GetAllocator() == Alloc(&arena2));
+            assert(v2.GetAllocator() == Alloc(&arena1));
+            assert(v1.Size() == SIZE / 2);
+
+            v1 = std::move(v2);
+            assert(v1.GetAllocator() == Alloc(&arena1));
+            assert(v1.Size() == SIZE);
+            assert(Obj::num_moved == 0);
+
+            Vector<Obj, Alloc> v3{ Alloc(&arena2) };
+            v3 = v1;
+            assert(v3.GetAllocator() == Alloc(&arena1));
+            assert(v3.Size() == SIZE);
+        }
+        assert(arena1.bytes_in_use == 0);
+        assert(arena2.bytes_in_use == 0);
+        assert(Obj::GetAliveObjectCount() == 0);
     }
-    C(C&& /*other*/) noexcept
+}
+
+void Test8()
+{
+    const int SIZE = 100;
+    static_assert(IsTriviallyRelocatableV<int>);
+    static_assert(IsTriviallyRelocatableV<std::unique_ptr<int>>);
+    static_assert(IsTriviallyRelocatableV<Vector<int>>);
+    static_assert(!IsTriviallyRelocatableV<Obj>);
     {
-        ++move_ctor;
+        RelocatableObj::num_moved = 0;
+        RelocatableObj::num_destroyed = 0;
+        Vector<RelocatableObj> v;
+        for (int i = 0; i < SIZE; ++i)
+        {
+            v.EmplaceBack(i);
+        }
+        v.Reserve(SIZE * 4);
+        assert(v.Capacity() == SIZE * 4);
+
+        // Вставка и удаление в середине сдвигают хвост побайтово
+        v.Emplace(v.begin() + SIZE / 2, -1);
+        v.Erase(v.begin());
+        v.Insert(v.begin(), RelocatableObj{ -2 });
+        assert(v.Size() == SIZE + 1);
+        assert(*v[0].id == -2);
+        assert(*v[1].id == 1);
+        assert(*v[SIZE / 2].id == -1);
+        assert(*v[SIZE].id == SIZE - 1);
+        for (int i = 1; i < SIZE / 2; ++i)
+        {
+            assert(*v[i].id == i);
+        }
+
+        // Перемещение понадобилось только для временного объекта, переданного в Insert
+        assert(RelocatableObj::num_moved == 1);
+        // Разрушены лишь удалённый элемент и временный объект
+        assert(RelocatableObj::num_destroyed == 2);
     }
-    C& operator=(const C& other) noexcept
+    assert(RelocatableObj::num_destroyed == SIZE + 3);
     {
-        if (this != &other)
+        Vector<Vector<int>> v;
+        for (int i = 0; i < SIZE; ++i)
+        {
+            v.EmplaceBack(static_cast<size_t>(i + 1));
+        }
+        for (int i = 0; i < SIZE; ++i)
         {
-            ++copy_assign;
+            assert(v[i].Size() == static_cast<size_t>(i + 1));
         }
-        return *this;
     }
-    C& operator=(C&& /*other*/) noexcept
+}
+
+void Test9()
+{
+    const int SIZE = 100'000;
     {
-        ++move_assign;
-        return *this;
+        Vector<int, MallocAllocator<int>> v;
+        for (int i = 0; i < SIZE; ++i)
+        {
+            v.PushBack(i);
+        }
+        v.Reserve(SIZE * 4);
+        assert(v.Capacity() >= SIZE * 4);
+        v.Insert(v.begin(), v[SIZE - 1]);
+        assert(v.Size() == SIZE + 1);
+        assert(v[0] == SIZE - 1);
+        for (int i = 0; i < SIZE; ++i)
+        {
+            assert(v[i + 1] == i);
+        }
     }
-    ~C()
     {
-        ++dtor;
+        RelocatableObj::num_moved = 0;
+        RelocatableObj::num_destroyed = 0;
+        {
+            Vector<RelocatableObj, MallocAllocator<RelocatableObj>> v;
+            for (int i = 0; i < SIZE; ++i)
+            {
+                v.Emplace(v.begin() + v.Size() / 2, i);
+            }
+            assert(v.Size() == SIZE);
+            assert(RelocatableObj::num_moved == 0);
+            assert(RelocatableObj::num_destroyed == 0);
+        }
+        assert(RelocatableObj::num_destroyed == SIZE);
     }
+}
 
-    static void Reset()
+void Test10()
+{
+    const size_t SIZE = 1000;
+    {
+        Vector<int, std::allocator<int>, OneAndHalfGrowth> v;
+        std::vector<size_t> capacities;
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            if (v.Size() == v.Capacity())
+            {
+                capacities.push_back(v.Capacity());
+            }
+            v.PushBack(static_cast<int>(i));
+        }
+        const std::vector<size_t> expected = { 0, 1, 2, 3, 4, 6, 9, 13, 19, 28, 42, 63, 94, 141, 211, 316, 474, 711 };
+        assert(capacities == expected);
+    }
     {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+        Vector<int, std::allocator<int>, GoldenRatioGrowth> v;
+        v.Reserve(8);
+        v.Resize(8);
+        v.PushBack(0);
+        assert(v.Capacity() == 13);
     }
+    {
+        struct Record
+        {
+            char data[24];
+        };
+        Vector<Record, std::allocator<Record>, PageRoundedGrowth<>> v;
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            v.PushBack(Record{});
+            const size_t bytes = v.Capacity() * sizeof(Record);
+            const size_t page_bytes = (bytes + 4095) / 4096 * 4096;
+            assert(page_bytes - bytes < sizeof(Record));
+        }
+    }
+    {
+        Vector<char, MallocAllocator<char>> v;
+        v.Reserve(1);
+        assert(v.Capacity() >= 1);
+#if defined(__GLIBC__)
+        // Вместимость совпадает с размерным классом malloc
+        assert(v.Capacity() == malloc_usable_size(v.begin()));
+#endif
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            v.PushBack(static_cast<char>(i));
+        }
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            assert(v[i] == static_cast<char>(i));
+        }
+    }
+}
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
-};
-
-void Dump()
+void Test11()
 {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-        << ", Copy ctors: "sv << C::copy_ctor          //
-        << ", Move ctors: "sv << C::move_ctor          //
-        << ", Copy assignments: "sv << C::copy_assign  //
-        << ", Move assignments: "sv << C::move_assign  //
-        << ", Dtors: "sv << C::dtor << endl;
+    const size_t SMALL = 8;
+    const size_t SIZE = 100;
+    const int ID = 42;
+    using namespace std::literals;
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, SMALL> v;
+        assert(v.IsInline());
+        assert(v.Capacity() == SMALL);
+        for (size_t i = 0; i < SMALL; ++i)
+        {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(v.IsInline());
+        assert(Obj::num_moved == 0);
+
+        v.EmplaceBack(ID, "Ivan"s);
+        assert(!v.IsInline());
+        assert(v.Capacity() == SMALL * 2);
+        assert(v[SMALL].name == "Ivan"s);
+        assert(Obj::num_moved == SMALL);
+        assert(Obj::GetAliveObjectCount() == SMALL + 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        Obj::default_construction_throw_countdown = SMALL / 2;
+        try
+        {
+            SmallVector<Obj, SMALL> v(SMALL);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, SMALL> v(SMALL);
+        v[SMALL / 2].throw_on_copy = true;
+        try
+        {
+            SmallVector<Obj, SMALL> v_copy(v);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+            assert(Obj::num_copied == SMALL / 2);
+        }
+        assert(Obj::GetAliveObjectCount() == SMALL);
+    }
+    {
+        SmallVector<TestObj, SMALL> v(SMALL);
+        // Вставка существующего элемента безопасна и при переносе во внешний буфер
+        v.PushBack(v[0]);
+        v.Insert(v.cbegin() + 2, v[0]);
+        v.Emplace(v.cbegin() + 2, std::move(v[0]));
+        assert(std::all_of(v.begin(), v.end(), [](const TestObj& obj)
+            {
+                return obj.IsAlive();
+            }));
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, SMALL> v(SIZE);
+        v[2].id = ID;
+        auto* pos = v.Erase(v.cbegin() + 1);
+        assert(pos->id == ID);
+        assert(v.Size() == SIZE - 1);
+        assert(Obj::num_move_assigned == SIZE - 2);
+        v.Resize(SMALL);
+        assert(!v.IsInline());
+        assert(Obj::GetAliveObjectCount() == SMALL);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, SMALL> small_v(SMALL / 2);
+        SmallVector<Obj, SMALL> large_v(SIZE);
+        small_v[0].id = ID;
+        large_v[SIZE - 1].id = ID;
+        small_v.Swap(large_v);
+        assert(small_v.Size() == SIZE && small_v[SIZE - 1].id == ID);
+        assert(large_v.Size() == SMALL / 2 && large_v[0].id == ID);
+        assert(large_v.IsInline());
+
+        SmallVector<Obj, SMALL> copy(small_v);
+        assert(copy.Capacity() == SIZE);
+        copy = large_v;
+        assert(copy.Size() == SMALL / 2 && copy[0].id == ID);
+
+        SmallVector<Obj, SMALL> moved(std::move(small_v));
+        assert(moved.Size() == SIZE && small_v.Size() == 0);
+        moved = std::move(large_v);
+        assert(moved.Size() == SMALL / 2 && moved[0].id == ID);
+        assert(Obj::GetAliveObjectCount() == SMALL);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Копирующее присваивание с распространяемым неравным аллокатором не портит вектор при исключении
+        using Alloc = ArenaAllocator<Obj, true>;
+        Alloc::Arena lhs_arena;
+        Alloc::Arena rhs_arena;
+        SmallVector<Obj, SMALL, Alloc> lhs(SIZE, Alloc(&lhs_arena));
+        lhs[SIZE - 1].id = ID;
+        SmallVector<Obj, SMALL, Alloc> rhs(SMALL / 2, Alloc(&rhs_arena));
+        rhs[SMALL / 2 - 1].throw_on_copy = true;
+        try
+        {
+            lhs = rhs;
+            assert(false);
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        assert(lhs.Size() == SIZE && lhs[SIZE - 1].id == ID && lhs.GetAllocator() == Alloc(&lhs_arena));
+
+        rhs[SMALL / 2 - 1].throw_on_copy = false;
+        rhs[0].id = ID;
+        lhs = rhs;
+        assert(lhs.IsInline() && lhs.Size() == SMALL / 2 && lhs[0].id == ID);
+        assert(lhs.GetAllocator() == Alloc(&rhs_arena));
+        assert(lhs_arena.allocations == lhs_arena.deallocations);
+
+        SmallVector<Obj, SMALL, Alloc> large_rhs(SIZE, Alloc(&lhs_arena));
+        lhs = large_rhs;
+        assert(!lhs.IsInline() && lhs.Size() == SIZE && lhs.GetAllocator() == Alloc(&lhs_arena));
+        assert(Obj::GetAliveObjectCount() == 2 * SIZE + SMALL / 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    static_assert(std::is_nothrow_move_assignable_v<SmallVector<Obj, SMALL>>);
+    static_assert(noexcept(std::declval<SmallVector<Obj, SMALL>&>().Swap(std::declval<SmallVector<Obj, SMALL>&>())));
+    static_assert(!std::is_nothrow_move_assignable_v<SmallVector<Obj, SMALL, ArenaAllocator<Obj, false>>>);
+    {
+        SmallVector<int, SMALL> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i)
+        {
+            v.Insert(v.begin(), i);
+        }
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            assert(v[i] == static_cast<int>(SIZE - 1 - i));
+        }
+        v.Reserve(SIZE * 2);
+        assert(v.Capacity() == SIZE * 2);
+    }
 }
 
-void Benchmark()
+void Test12()
 {
-    using namespace std;
-    try
+    const size_t SIZE = 100;
+    const size_t COUNT = 30;
+    {
+        std::vector<int> source(SIZE);
+        std::iota(source.begin(), source.end(), 0);
+        Vector<int> v(source.begin(), source.end());
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(std::equal(v.begin(), v.end(), source.begin()));
+
+        // Вставка в середину с одной реаллокацией
+        const std::vector<int> extra(COUNT, -1);
+        auto pos = v.Insert(v.cbegin() + SIZE / 2, extra.begin(), extra.end());
+        source.insert(source.begin() + SIZE / 2, extra.begin(), extra.end());
+        assert(pos == v.begin() + SIZE / 2);
+        assert(v.Capacity() == SIZE * 2);
+        assert(std::equal(v.begin(), v.end(), source.begin(), source.end()));
+
+        // Вставка без реаллокации, диапазон короче и длиннее хвоста
+        v.Insert(v.cbegin() + 1, extra.begin(), extra.begin() + 3);
+        source.insert(source.begin() + 1, extra.begin(), extra.begin() + 3);
+        v.Insert(v.cend() - 2, extra.begin(), extra.begin() + 5);
+        source.insert(source.end() - 2, extra.begin(), extra.begin() + 5);
+        assert(std::equal(v.begin(), v.end(), source.begin(), source.end()));
+
+        const std::list<int> tail = { 7, 8, 9 };
+        v.Append(tail.begin(), tail.end());
+        assert(v[v.Size() - 1] == 9);
+
+        v.Assign(tail.begin(), tail.end());
+        assert(v.Size() == 3 && v[0] == 7);
+    }
+    {
+        // Однопроходные итераторы
+        std::istringstream input("1 2 3 4");
+        Vector<int> v(std::istream_iterator<int>(input), std::istream_iterator<int>{});
+        assert(v.Size() == 4 && v[3] == 4);
+        std::istringstream more("10 20");
+        v.Insert(v.cbegin() + 1, std::istream_iterator<int>(more), std::istream_iterator<int>{});
+        const std::vector<int> expected = { 1, 10, 20, 2, 3, 4 };
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+    {
+        // Хвост сдвигается один раз: O(n + k) перемещений вместо O(n * k)
+        Obj::ResetCounters();
+        std::vector<Obj> extra(COUNT);
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE + COUNT);
+        v[SIZE - 1].id = 1;
+        extra[0].id = 2;
+        const int old_moved = Obj::num_moved;
+        v.Insert(v.cbegin() + 10, extra.begin(), extra.end());
+        assert(v.Size() == SIZE + COUNT);
+        assert(v[10].id == 2);
+        assert(v[SIZE + COUNT - 1].id == 1);
+        assert(Obj::num_moved - old_moved + Obj::num_move_assigned == static_cast<int>(SIZE - 10));
+        assert(Obj::num_copied + Obj::num_assigned == static_cast<int>(COUNT));
+    }
     {
-        const size_t NUM = 10;
-        C c;
+        // Исключение при копировании диапазона не изменяет вектор
+        Obj::ResetCounters();
+        std::vector<Obj> extra(COUNT);
+        extra[COUNT / 2].throw_on_copy = true;
+        Vector<Obj> v(SIZE);
+        v[0].id = 1;
+        try
+        {
+            v.Insert(v.cbegin(), extra.begin(), extra.end());
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
         {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
         }
-        Dump();
+        assert(v.Size() == SIZE && v.Capacity() == SIZE && v[0].id == 1);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE + COUNT));
     }
-    catch (...)
+}
+
+void Test13()
+{
+    const size_t SIZE = 100;
     {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            v[i].id = static_cast<int>(i);
+        }
+        auto* pos = v.Erase(v.cbegin() + 10, v.cbegin() + 20);
+        assert(pos->id == 20);
+        assert(v.Size() == SIZE - 10);
+        assert(Obj::num_move_assigned == static_cast<int>(SIZE - 20));
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE - 10));
+
+        // Удаление всех нечётных за один проход
+        Obj::ResetCounters();
+        const size_t removed = EraseIf(v, [](const Obj& obj)
+            {
+                return obj.id % 2 != 0;
+            });
+        assert(removed == (SIZE - 10) / 2);
+        assert(v.Size() == (SIZE - 10) / 2);
+        assert(std::all_of(v.begin(), v.end(), [](const Obj& obj)
+            {
+                return obj.id % 2 == 0;
+            }));
+        assert(std::is_sorted(v.begin(), v.end(), [](const Obj& lhs, const Obj& rhs)
+            {
+                return lhs.id < rhs.id;
+            }));
+        assert(Obj::num_move_assigned < static_cast<int>(SIZE));
+        assert(Obj::num_destroyed == static_cast<int>(removed));
+
+        Obj::ResetCounters();
+        const int last_id = v[v.Size() - 1].id;
+        pos = v.SwapErase(v.cbegin());
+        assert(pos->id == last_id);
+        assert(Obj::num_move_assigned == 1);
+        assert(Obj::num_destroyed == 1);
+        pos = v.SwapErase(v.cend() - 1);
+        assert(pos == v.end());
     }
-    try
     {
-        const size_t NUM = 10;
-        C c;
+        Vector<RelocatableObj> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i)
         {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+            v.EmplaceBack(i);
         }
-        Dump();
+        v.SwapErase(v.cbegin() + 1);
+        assert(*v[1].id == static_cast<int>(SIZE - 1));
+        v.Erase(v.cbegin(), v.cbegin() + 2);
+        assert(*v[0].id == 2);
+        assert(EraseIf(v, [](const RelocatableObj& obj)
+            {
+                return *obj.id < 50;
+            }) == 48);
+        assert(v.Size() == SIZE - 3 - 48);
+    }
+}
+
+void Test14()
+{
+    const size_t SIZE = 1000;
+    const int MAGIC = 42;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE, DEFAULT_INIT);
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(Obj::num_default_constructed == static_cast<int>(SIZE));
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(Obj::num_default_constructed == static_cast<int>(SIZE * 2));
+        v.ResizeDefaultInit(SIZE);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE));
     }
-    catch (...)
     {
+        Vector<int> v(SIZE);
+        std::fill(v.begin(), v.end(), MAGIC);
+        v.Resize(0);
+        // Память не заполняется нулями: новые элементы сохраняют прежнее содержимое буфера
+        v.ResizeUninitialized(SIZE);
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(std::all_of(v.begin(), v.end(), [MAGIC](int value)
+            {
+                return value == MAGIC;
+            }));
+        v.ResizeUninitialized(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+        assert(v[SIZE - 1] == MAGIC);
+    }
+}
+
+void Test15()
+{
+    const size_t SIZE = 1000;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        v.ShrinkTo(SIZE + 10);
+        assert(v.Capacity() == SIZE + 10);
+        v.ShrinkTo(1);
+        assert(v.Capacity() == SIZE);
+        v.Resize(10);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 10);
+        assert(Obj::GetAliveObjectCount() == 10);
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+        assert(v.begin() == nullptr);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<int, std::allocator<int>, HysteresisShrink<>> v;
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Capacity() == 1024);
+        // Вместимость уменьшается, когда вектор заполнен меньше чем на четверть
+        while (v.Size() > 256)
+        {
+            v.PopBack();
+            assert(v.Capacity() == 1024);
+        }
+        v.PopBack();
+        assert(v.Size() == 255);
+        assert(v.Capacity() == 510);
+        assert(v[254] == 254);
+
+        // На границе порога чередование вставок и удалений не вызывает реаллокаций
+        const int* data = v.begin();
+        for (int i = 0; i < 100; ++i)
+        {
+            v.PushBack(i);
+            v.PopBack();
+        }
+        assert(v.begin() == data);
+
+        v.Erase(v.begin(), v.begin() + 200);
+        assert(v.Size() == 55);
+        assert(v.Capacity() == 110);
+        v.Clear();
+        assert(v.Capacity() == 16);
+    }
+}
+
+void Test16()
+{
+    const size_t SIZE = 1'000'000;
+    {
+        // Буфер переходит из кучи в отображение и растёт через mremap
+        Vector<int, MmapAllocator<int, size_t{ 1 } << 16>> v;
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Capacity() * sizeof(int) % MmapAllocator<int>::HUGE_PAGE_SIZE == 0);
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % MmapAllocator<int>::HUGE_PAGE_SIZE == 0);
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            assert(v[i] == static_cast<int>(i));
+        }
+
+        // Страницы хвоста возвращаются системе, вместимость сохраняется
+        const size_t capacity = v.Capacity();
+        v.Resize(SIZE / 2);
+        assert(v.Capacity() == capacity);
+        assert(v[SIZE / 2 - 1] == static_cast<int>(SIZE / 2 - 1));
+        v.Clear();
+        v.ResizeUninitialized(SIZE);
+        assert(v[SIZE - 1] == 0);
+
+        v.ShrinkTo(10);
+        assert(v.Capacity() == capacity);
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            Vector<Obj, MmapAllocator<Obj, size_t{ 1 } << 16, MMAP_HUGETLB | MMAP_POPULATE>> v(SIZE / 10);
+            v.PushBack(Obj{ 1 });
+            assert(v[SIZE / 10].id == 1);
+            Vector<Obj, MmapAllocator<Obj, size_t{ 1 } << 16, MMAP_HUGETLB | MMAP_POPULATE>> v_copy(v);
+            assert(v_copy.Size() == SIZE / 10 + 1);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // Длина отображения с округлением и запасом на выравнивание переполнила бы size_t
+        MmapAllocator<char> alloc;
+        try
+        {
+            (void)alloc.allocate(SIZE_MAX - MmapAllocator<char>::HUGE_PAGE_SIZE);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::bad_array_new_length&)
+        {
+        }
+    }
+}
+
+void Test17()
+{
+    struct Record
+    {
+        uint64_t id;
+        double value;
+    };
+    const size_t SIZE = 100'000;
+    const std::string path = "/tmp/advanced_vector_test_" + std::to_string(getpid()) + ".bin";
+    unlink(path.c_str());
+    {
+        MappedVector<Record> v(path);
+        assert(v.Size() == 0);
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            v.PushBack(Record{ i, i * 0.5 });
+        }
+        v.EmplaceBack(v[0]);
+        assert(v.Size() == SIZE + 1);
+        assert(v.Capacity() >= v.Size());
+        v.PopBack();
+        v.Sync();
+    }
+    {
+        // Содержимое доступно сразу после повторного открытия файла
+        MappedVector<Record> v(path);
+        assert(v.Size() == SIZE);
+        size_t i = 0;
+        for (const Record& record : v)
+        {
+            assert(record.id == i && record.value == i * 0.5);
+            ++i;
+        }
+        v.Resize(SIZE * 2);
+        assert(v[SIZE * 2 - 1].id == 0);
+        v.Clear();
+        assert(v.Size() == 0);
+
+        // Перемещённый вектор пуст, и его можно очищать
+        MappedVector<Record> moved(std::move(v));
+        assert(v.Size() == 0 && v.Capacity() == 0 && v.begin() == v.end());
+        v.Clear();
+        v.Resize(0);
+        v.PopBack();
+        moved.PushBack(Record{ 1, 1.0 });
+        moved.Clear();
+    }
+    try
+    {
+        MappedVector<int> v(path);
+        assert(false && "Exception is expected");
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    {
+        // Вместимость, при которой размер файла переполняется, не проходит проверку заголовка
+        {
+            MappedVector<Record> v(path);
+        }
+        int fd = open(path.c_str(), O_RDWR);
+        const uint64_t capacity = uint64_t{ 1 } << 60;  // capacity * sizeof(Record) == 2^64
+        assert(pwrite(fd, &capacity, sizeof(capacity), offsetof(MappedVectorHeader, capacity)) == sizeof(capacity));
+        close(fd);
+        try
+        {
+            MappedVector<Record> v(path);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+    unlink(path.c_str());
+}
+
+void Test18()
+{
+    struct Sample
+    {
+        uint32_t id;
+        float value;
+    };
+    const size_t SIZE = 10'000;
+    const std::string path = "/tmp/advanced_vector_io_" + std::to_string(getpid()) + ".bin";
+    {
+        Vector<Sample> v;
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            v.PushBack(Sample{ static_cast<uint32_t>(i), i * 0.25f });
+        }
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        WriteVector(fd, v);
+        lseek(fd, 0, SEEK_SET);
+        Vector<Sample, MallocAllocator<Sample>> read(3);
+        ReadVector(fd, read);
+        assert(read.Size() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            assert(read[i].id == i && read[i].value == i * 0.25f);
+        }
+        lseek(fd, 0, SEEK_SET);
+        try
+        {
+            Vector<uint32_t> wrong;
+            ReadVector(fd, wrong);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        close(fd);
+    }
+    {
+        // Потоковая запись частями и чтение частями другого размера
+        int fd = open(path.c_str(), O_RDWR | O_TRUNC);
+        VectorWriter<int> writer(fd);
+        Vector<int> chunk(1000);
+        for (int part = 0; part < 5; ++part)
+        {
+            std::iota(chunk.begin(), chunk.end(), part * 1000);
+            writer.Write(chunk);
+        }
+        writer.Finish();
+        assert(writer.Count() == 5000);
+
+        lseek(fd, 0, SEEK_SET);
+        VectorReader<int> reader(fd);
+        int expected = 0;
+        while (!reader.Done())
+        {
+            const size_t n = reader.ReadChunk(chunk, 1536);
+            assert(n == chunk.Size() && n > 0);
+            for (int x : chunk)
+            {
+                assert(x == expected++);
+            }
+        }
+        assert(expected == 5000);
+
+        // Обрезанный файл
+        assert(ftruncate(fd, sizeof(VectorStreamHeader) + 100 * sizeof(int)) == 0);
+        lseek(fd, 0, SEEK_SET);
+        try
+        {
+            Vector<int> v;
+            ReadVector(fd, v);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        close(fd);
+    }
+    {
+        // В канал число элементов не дописывается, поток читается до конца
+        int fds[2];
+        assert(pipe(fds) == 0);
+        {
+            VectorWriter<int> writer(fds[1]);
+            Vector<int> chunk(100);
+            std::iota(chunk.begin(), chunk.end(), 0);
+            writer.Write(chunk);
+            writer.Write(chunk);
+            writer.Finish();
+        }
+        close(fds[1]);
+        Vector<int> v;
+        ReadVector(fds[0], v);
+        close(fds[0]);
+        assert(v.Size() == 200 && v[150] == 50);
+    }
+    {
+        // Повреждённое число элементов в заголовке отвергается до выделения памяти под них
+        const auto write_stream = [](int fd, uint64_t count) {
+            VectorStreamHeader header{ VectorStreamHeader::MAGIC, VectorStreamHeader::VERSION, sizeof(int), count };
+            Vector<int> data(100);
+            assert(write(fd, &header, sizeof(header)) == sizeof(header));
+            assert(write(fd, data.begin(), data.Size() * sizeof(int)) == static_cast<ssize_t>(data.Size() * sizeof(int)));
+        };
+        for (uint64_t count : { uint64_t{ 1 } << 62, uint64_t{ 1 } << 40, uint64_t{ 101 } })
+        {
+            int fd = open(path.c_str(), O_RDWR | O_TRUNC);
+            write_stream(fd, count);
+            lseek(fd, 0, SEEK_SET);
+            try
+            {
+                Vector<int> v;
+                ReadVector(fd, v);
+                assert(false && "Exception is expected");
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+            close(fd);
+        }
+
+        // В канале размер данных заранее неизвестен: чтение идёт ограниченными частями до конца потока
+        int fds[2];
+        assert(pipe(fds) == 0);
+        write_stream(fds[1], uint64_t{ 1 } << 40);
+        close(fds[1]);
+        try
+        {
+            Vector<int> v;
+            ReadVector(fds[0], v);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        close(fds[0]);
+    }
+    unlink(path.c_str());
+}
+
+void Test19()
+{
+    using ParallelVector = Vector<AtomicCountedObj, std::allocator<AtomicCountedObj>, DoublingGrowth, ParallelExecution<1024>>;
+    const int SIZE = 100'000;
+    {
+        ParallelVector v(SIZE);
+        assert(AtomicCountedObj::num_alive == SIZE);
+        for (int i = 0; i < SIZE; ++i)
+        {
+            v[i].id = i;
+        }
+
+        ParallelVector copy(v);
+        assert(copy.Size() == SIZE && AtomicCountedObj::num_alive == 2 * SIZE);
+        for (int i = 0; i < SIZE; ++i)
+        {
+            assert(copy[i].id == i);
+        }
+
+        // Исключение посреди параллельного копирования: построенные части разрушаются
+        AtomicCountedObj::throw_countdown = SIZE / 2;
+        try
+        {
+            ParallelVector failed_copy(v);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        assert(AtomicCountedObj::num_alive == 2 * SIZE);
+
+        ParallelVector small(10);
+        AtomicCountedObj::throw_countdown = SIZE - 1;
+        try
+        {
+            small = v;
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        AtomicCountedObj::throw_countdown = 0;
+        assert(small.Size() == 10 && AtomicCountedObj::num_alive == 2 * SIZE + 10);
+
+        // Вместимости хватает, но исключение в одной из частей не должно затронуть имеющиеся элементы
+        ParallelVector large(SIZE / 2);
+        large.Reserve(SIZE);
+        for (int i = 0; i < SIZE / 2; ++i)
+        {
+            large[i].id = -i;
+        }
+        AtomicCountedObj::throw_countdown = SIZE - 1;
+        try
+        {
+            large = v;
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        AtomicCountedObj::throw_countdown = 0;
+        assert(large.Size() == SIZE / 2 && large[SIZE / 2 - 1].id == -(SIZE / 2 - 1));
+        assert(AtomicCountedObj::num_alive == 2 * SIZE + 10 + SIZE / 2);
+        large.Clear();
+
+        small = v;
+        assert(small.Size() == SIZE && small[SIZE - 1].id == SIZE - 1);
+        assert(AtomicCountedObj::num_alive == 3 * SIZE);
+    }
+    assert(AtomicCountedObj::num_alive == 0);
+    {
+        // Вложенные параллельные операции
+        using Inner = Vector<int, std::allocator<int>, DoublingGrowth, ParallelExecution<1024>>;
+        Vector<Inner, std::allocator<Inner>, DoublingGrowth, ParallelExecution<16>> matrix(64);
+        for (Inner& row : matrix)
+        {
+            row.Resize(4096);
+            std::iota(row.begin(), row.end(), 0);
+        }
+        auto copy = matrix;
+        assert(copy.Size() == 64 && copy[63][4095] == 4095);
+    }
+}
+
+void Test20()
+{
+    using Alloc = NumaAllocator<int>;
+    const size_t SIZE = 1 << 20;
+    const uint64_t NODE0 = 1;
+    for (NumaPlacement placement : { NUMA_LOCAL, NUMA_INTERLEAVE, NUMA_BIND, NUMA_PARTITIONED })
+    {
+        Vector<int, Alloc> v(SIZE, Alloc(placement, NODE0));
+        assert(v.Capacity() >= SIZE);
+        assert(v.GetAllocator().Placement() == placement);
+        assert(NumaNodeOfRange(v.begin(), SIZE * sizeof(int)) == 0);
+
+        // Размещение переходит к копии вместе с аллокатором
+        Vector<int, Alloc> copy(v);
+        assert(copy.GetAllocator().Placement() == placement);
+        assert(NumaNodeOfRange(copy.begin(), SIZE * sizeof(int)) == 0);
+    }
+    {
+        // Страницы, к которым не было обращений, ещё не размещены
+        Vector<int, Alloc> v(Alloc(NUMA_BIND, NODE0));
+        v.Reserve(SIZE);
+        assert(NumaNodeOfRange(v.begin(), SIZE * sizeof(int)) == -1);
+        assert(NumaPageNodes(v.begin(), SIZE * sizeof(int))[0] == -ENOENT);
+        v.Resize(SIZE / 2);
+        const Vector<int> nodes = NumaPageNodes(v.begin(), SIZE * sizeof(int));
+        assert(nodes[0] == 0 && nodes[nodes.Size() - 1] == -ENOENT);
+    }
+    {
+        // Аллокаторы с разным размещением не равны: присваивание переносит размещение вместе с новым буфером
+        assert(Alloc(NUMA_BIND, NODE0) == Alloc(NUMA_BIND, NODE0));
+        assert(Alloc(NUMA_BIND, NODE0) != Alloc(NUMA_INTERLEAVE, NODE0) && Alloc(NUMA_BIND, NODE0) != Alloc(NUMA_BIND, 3));
+        Vector<int, Alloc> bound(SIZE, Alloc(NUMA_BIND, NODE0));
+        Vector<int, Alloc> interleaved(SIZE / 2, Alloc(NUMA_INTERLEAVE, NODE0));
+        interleaved = bound;
+        assert(interleaved.GetAllocator() == bound.GetAllocator() && interleaved.Size() == SIZE);
+        assert(NumaNodeOfRange(interleaved.begin(), SIZE * sizeof(int)) == 0);
+    }
+    {
+        // Небольшие буферы выделяются без mmap
+        Vector<int, Alloc> v(10, Alloc(NUMA_BIND, NODE0));
+        assert(v.Capacity() == 10);
+    }
+    try
+    {
+        Vector<int, Alloc> v(SIZE, Alloc(NUMA_BIND, uint64_t{ 1 } << 63));
+        assert(false && "Exception is expected");
+    }
+    catch (const std::system_error&)
+    {
+    }
+    try
+    {
+        // Длина отображения, округлённая до страницы, переполнила бы size_t
+        (void)NumaAllocator<char>(NUMA_LOCAL, NODE0).allocate(SIZE_MAX - 1);
+        assert(false && "Exception is expected");
+    }
+    catch (const std::bad_array_new_length&)
+    {
+    }
+}
+
+void Test21()
+{
+    using Layout = SegmentLayout<4>;
+    assert(Layout::Locate(0).segment == 0 && Layout::Locate(3).offset == 3);
+    assert(Layout::Locate(4).segment == 1 && Layout::Locate(4).offset == 0);
+    assert(Layout::Locate(11).segment == 1 && Layout::Locate(11).offset == 7);
+    assert(Layout::Locate(12).segment == 2 && Layout::SegmentBegin(2) == 12 && Layout::SegmentSize(2) == 16);
+    assert(Layout::SegmentCountFor(0) == 0 && Layout::SegmentCountFor(12) == 2 && Layout::SegmentCountFor(13) == 3);
+
+    struct Entry
+    {
+        int thread;
+        int sequence;
+    };
+    const int THREADS = 8;
+    const int PER_THREAD = 50'000;
+    ConcurrentVector<Entry, std::allocator<Entry>, 16> log;
+    Entry* first = &log.EmplaceBack(Entry{ -1, -1 });
+
+    Vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        producers.EmplaceBack([&log, t] {
+            for (int i = 0; i < PER_THREAD; ++i)
+            {
+                log.PushBack(Entry{ t, i });
+            }
+        });
+    }
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    assert(log.Size() == THREADS * PER_THREAD + 1);
+    assert(&log[0] == first && first->thread == -1);
+    // Элементы каждого потока идут в порядке добавления
+    Vector<int> next(THREADS);
+    for (size_t i = 1; i < log.Size(); ++i)
+    {
+        assert(log.IsReady(i));
+        const Entry& entry = log[i];
+        assert(entry.sequence == next[entry.thread]++);
+    }
+    for (int count : next)
+    {
+        assert(count == PER_THREAD);
+    }
+    assert(!log.IsReady(log.Size()));
+
+    {
+        // Слот, в котором конструктор выбросил исключение, остаётся пустым
+        ConcurrentVector<AtomicCountedObj> v;
+        v.Reserve(100);
+        v.EmplaceBack();
+        AtomicCountedObj::throw_countdown = 1;
+        try
+        {
+            v.EmplaceBack();
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        v.EmplaceBack();
+        assert(v.Size() == 3 && v.IsReady(0) && !v.IsReady(1) && v.IsReady(2));
+        assert(AtomicCountedObj::num_alive == 2);
+    }
+    assert(AtomicCountedObj::num_alive == 0);
+}
+
+void Test22()
+{
+    const int SIZE = 100'000;
+    {
+        SegmentedVector<int> v;
+        int* first = &v.EmplaceBack(0);
+        auto first_it = v.begin();
+        Vector<int*> addresses;
+        for (int i = 1; i < SIZE; ++i)
+        {
+            addresses.PushBack(&v.EmplaceBack(i));
+        }
+        assert(v.Size() == SIZE && v.Capacity() >= SIZE);
+        // Элементы не перемещаются при росте
+        assert(&v[0] == first && *first_it == 0);
+        for (int i = 1; i < SIZE; ++i)
+        {
+            assert(addresses[i - 1] == &v[i] && v[i] == i);
+        }
+        assert(std::accumulate(v.begin(), v.end(), 0LL) == 1LL * SIZE * (SIZE - 1) / 2);
+
+        std::sort(v.begin(), v.end(), std::greater<int>());
+        assert(v[0] == SIZE - 1 && *(v.end() - 1) == 0 && std::is_sorted(v.cbegin(), v.cend(), std::greater<int>()));
+
+        v.Resize(10);
+        v.ShrinkToFit();
+        assert(v.Size() == 10 && v.Capacity() == 16);
+        v.Insert(v.begin() + 2, -1);
+        assert(v.Size() == 11 && v[2] == -1 && v[3] == SIZE - 3);
+        v.Erase(v.begin());
+        assert(v.Size() == 10 && v[1] == -1);
+
+        // Аргумент ссылается на элемент вектора в момент выделения нового сегмента
+        SegmentedVector<int> w(16);
+        w[15] = 42;
+        w.PushBack(w[15]);
+        assert(w.Size() == 17 && w[16] == 42 && w.Capacity() == 48);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            SegmentedVector<Obj> v(100);
+            v[99].id = 42;
+            SegmentedVector<Obj> copy(v);
+            assert(copy.Size() == 100 && copy[99].id == 42);
+
+            SegmentedVector<Obj> moved(std::move(copy));
+            assert(moved.Size() == 100 && copy.Size() == 0 && moved[99].id == 42);
+
+            Obj::default_construction_throw_countdown = 50;
+            try
+            {
+                moved.Resize(200);
+                assert(false && "Exception is expected");
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+            assert(moved.Size() == 100);
+            assert(Obj::GetAliveObjectCount() == 200);
+
+            v[0].throw_on_copy = true;
+            try
+            {
+                moved = v;
+                assert(false && "Exception is expected");
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+            assert(moved.Size() == 100 && moved[99].id == 42 && Obj::GetAliveObjectCount() == 200);
+            v[0].throw_on_copy = false;
+
+            moved.Resize(10);
+            moved = v;
+            assert(moved.Size() == 100 && Obj::GetAliveObjectCount() == 200);
+            v.Swap(moved);
+            v = std::move(moved);
+            assert(moved.Size() == 0 && v.Size() == 100);
+
+            // Элементы с перемещением без исключений сдвигаются перемещением
+            const int move_assigned_before = Obj::num_move_assigned;
+            v.Erase(v.begin() + 98);
+            assert(v.Size() == 99 && v[98].id == 42 && Obj::num_move_assigned == move_assigned_before + 1);
+
+            // Удаление из пустого вектора ничего не делает, как у Vector
+            moved.PopBack();
+            assert(moved.Size() == 0 && Obj::GetAliveObjectCount() == 99);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test23()
+{
+    const int SIZE = 1000;
+    const size_t STEP = 2;
+    Obj::ResetCounters();
+    {
+        IncrementalVector<Obj, std::allocator<Obj>, STEP> v;
+        bool migrated = false;
+        for (int i = 0; i < SIZE; ++i)
+        {
+            const int moved_before = Obj::num_moved;
+            v.EmplaceBack(i);
+            // Ни одна вставка не переносит больше STEP элементов
+            assert(Obj::num_moved - moved_before <= static_cast<int>(STEP));
+            migrated = migrated || v.IsMigrating();
+            assert(v[i / 2].id == i / 2 && v[i].id == i);
+        }
+        assert(migrated);
+        assert(v.Size() == SIZE && Obj::num_copied == 0);
+        assert(Obj::GetAliveObjectCount() == SIZE);
+
+        // Удаление элементов, ещё не перенесённых из прежнего буфера
+        while (!v.IsMigrating())
+        {
+            v.EmplaceBack(static_cast<int>(v.Size()));
+        }
+        const size_t size = v.Size();
+        v.PopBack();
+        v.PopBack();
+        assert(v.Size() == size - 2 && v[size - 3].id == static_cast<int>(size - 3));
+
+        // Доступ по индексу не переносит элементы: ссылки остаются действительными
+        assert(v.IsMigrating());
+        Obj& last = v[v.Size() - 1];
+        const int moved_before = Obj::num_moved;
+        std::swap(v[0].id, v[v.Size() - 1].id);
+        v[1] = v[v.Size() - 1];
+        assert(Obj::num_moved == moved_before && &last == &v[v.Size() - 1] && last.id == 0 && v[1].id == 0);
+        std::swap(v[0].id, v[v.Size() - 1].id);
+        v[1].id = 1;
+
+        const IncrementalVector<Obj, std::allocator<Obj>, STEP> copy(v);
+        assert(!copy.IsMigrating() && copy.Size() == v.Size());
+        for (size_t i = 0; i < copy.Size(); ++i)
+        {
+            assert(copy[i].id == static_cast<int>(i));
+        }
+
+        // Неконстантные итераторы завершают перенос
+        assert(v.IsMigrating());
+        int expected = 0;
+        for (const Obj& obj : v)
+        {
+            assert(obj.id == expected++);
+        }
+        assert(!v.IsMigrating() && expected == static_cast<int>(v.Size()));
+
+        v.Reserve(v.Capacity() * 2);
+        assert(!v.IsMigrating() && v[v.Size() - 1].id == static_cast<int>(v.Size() - 1));
+        v.Clear();
+        assert(v.Size() == 0 && Obj::GetAliveObjectCount() == static_cast<int>(copy.Size()));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Тривиально перемещаемые элементы переносятся побайтово
+        IncrementalVector<std::unique_ptr<int>> v;
+        for (int i = 0; i < SIZE; ++i)
+        {
+            v.PushBack(std::make_unique<int>(i));
+        }
+        for (int i = 0; i < SIZE; ++i)
+        {
+            assert(*v[i] == i);
+        }
+        IncrementalVector<std::unique_ptr<int>> moved(std::move(v));
+        assert(moved.Size() == SIZE && v.Size() == 0);
+    }
+}
+
+void Test24()
+{
+    const int SIZE = 1000;
+    {
+        SoaVector<float, float, float, uint32_t> points;
+        for (int i = 0; i < SIZE; ++i)
+        {
+            points.EmplaceBack(i * 1.0f, i * 2.0f, i * 3.0f, static_cast<uint32_t>(i));
+        }
+        assert(points.Size() == SIZE && points.Capacity() >= SIZE);
+
+        // Проход по одному столбцу
+        const auto ids = points.Column<3>();
+        assert(ids.Size() == SIZE && std::accumulate(ids.begin(), ids.end(), 0u) == SIZE * (SIZE - 1) / 2);
+        float sum = 0;
+        for (float y : points.Column<1>())
+        {
+            sum += y;
+        }
+        assert(sum == SIZE * (SIZE - 1.0f));
+
+        // Строка - кортеж ссылок на поля
+        auto [x, y, z, id] = points[10];
+        assert(x == 10.0f && y == 20.0f && z == 30.0f && id == 10);
+        x = -1.0f;
+        assert(points.Column<0>()[10] == -1.0f);
+        std::get<3>(points[11]) = 7;
+        assert(std::get<3>(std::as_const(points)[11]) == 7);
+
+        points.Erase(0, 10);
+        assert(points.Size() == SIZE - 10 && std::get<0>(points[0]) == -1.0f && std::get<3>(points[1]) == 7);
+        points.Erase(0);
+        assert(std::get<3>(points[0]) == 7);
+        points.Resize(5);
+        points.Resize(10);
+        assert(points.Size() == 10 && std::get<2>(points[9]) == 0.0f);
+        points.PopBack();
+        assert(points.Size() == 9);
+    }
+    Obj::ResetCounters();
+    {
+        SoaVector<std::string, Obj> v;
+        v.EmplaceBack("a", 1);
+        // Аргументы ссылаются на элементы вектора в момент роста
+        v.EmplaceBack(std::get<0>(v[0]), std::get<1>(v[0]));
+        assert(v.Size() == 2 && std::get<0>(v[1]) == "a" && std::get<1>(v[1]).id == 1);
+
+        SoaVector<std::string, Obj> copy(v);
+        assert(copy.Size() == 2 && std::get<0>(copy[1]) == "a");
+
+        // Исключение в конструкторе поля: уже созданные поля строк разрушаются, размер не меняется
+        Obj::default_construction_throw_countdown = 3;
+        try
+        {
+            v.Resize(10);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        assert(v.Size() == 2 && Obj::GetAliveObjectCount() == 4);
+
+        std::get<1>(v[0]).throw_on_copy = true;
+        try
+        {
+            copy = v;
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        assert(copy.Size() == 2 && Obj::GetAliveObjectCount() == 4);
+
+        SoaVector<std::string, Obj> moved(std::move(copy));
+        assert(moved.Size() == 2 && copy.Size() == 0);
+        moved.Clear();
+        assert(Obj::GetAliveObjectCount() == 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Удаление пустого диапазона ничего не меняет, удаление хвоста не сдвигает элементов
+        const std::string LONG = "long string without small buffer optimization";
+        SoaVector<int, std::string> v;
+        for (int i = 0; i < 3; ++i)
+        {
+            v.EmplaceBack(i, LONG + std::to_string(i));
+        }
+        v.Erase(1, 1);
+        v.Erase(3, 3);
+        assert(v.Size() == 3);
+        for (int i = 0; i < 3; ++i)
+        {
+            assert(std::get<0>(v[i]) == i && std::get<1>(v[i]) == LONG + std::to_string(i));
+        }
+        v.Erase(1, 3);
+        assert(v.Size() == 1 && std::get<1>(v[0]) == LONG + "0");
+    }
+}
+
+// Сравнивает алгоритмы Simd* с поэлементными на всех размерах до 3 векторов AVX-512 и остатках
+template <typename T>
+void CheckSimdAlgorithms()
+{
+    for (size_t size = 0; size <= 3 * 64 + 1; ++size)
+    {
+        Vector<T> v(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            v[i] = static_cast<T>((i * 7) % 13);
+        }
+        const std::vector<T> expected(v.begin(), v.end());
+
+        assert(SimdFind(v, T(5)) == static_cast<size_t>(std::find(expected.begin(), expected.end(), T(5)) - expected.begin()));
+        assert(SimdFind(v, T(100)) == size);
+        assert(SimdCount(v, T(3)) == static_cast<size_t>(std::count(expected.begin(), expected.end(), T(3))));
+        assert(SimdSum(v) == std::accumulate(expected.begin(), expected.end(), T{}));
+        assert(SimdDot(v, v) == std::inner_product(expected.begin(), expected.end(), expected.begin(), T{}));
+        if (size > 0)
+        {
+            const auto [min, max] = std::minmax_element(expected.begin(), expected.end());
+            assert(SimdMinMax(v) == std::make_pair(*min, *max));
+        }
+
+        Vector<T> erased(v);
+        const size_t removed = SimdEraseIf(erased, SIMD_GREATER_EQUAL, T(6));
+        std::vector<T> kept(expected);
+        kept.erase(std::remove_if(kept.begin(), kept.end(), [](T x) { return x >= T(6); }), kept.end());
+        assert(removed == size - kept.size() && std::equal(erased.begin(), erased.end(), kept.begin(), kept.end()));
+
+        SimdMultiplyAdd(v, T(2), T(1));
+        SimdAdd(v, T(1));
+        SimdMultiply(v, T(3));
+        for (size_t i = 0; i < size; ++i)
+        {
+            assert(v[i] == static_cast<T>((expected[i] * 2 + 1 + 1) * 3));
+        }
+        SimdFill(v, 9);
+        assert(std::all_of(v.begin(), v.end(), [](T x) { return x == T(9); }));
+    }
+}
+
+void Test25()
+{
+    const SimdLevel detected = GetSimdLevel();
+    for (SimdLevel level : { SIMD_SCALAR, SIMD_BASELINE, SIMD_AVX2, SIMD_AVX512 })
+    {
+        LimitSimdLevel(level);
+        assert(GetSimdLevel() == std::min(level, detected));
+        CheckSimdAlgorithms<int8_t>();
+        CheckSimdAlgorithms<uint16_t>();
+        CheckSimdAlgorithms<int32_t>();
+        CheckSimdAlgorithms<uint64_t>();
+        CheckSimdAlgorithms<float>();
+        CheckSimdAlgorithms<double>();
+    }
+    assert(GetSimdLevel() == detected);
+
+    {
+        // Счётчики дорожек int8 переполнились бы без периодического сброса
+        Vector<int8_t> v(100000);
+        SimdFill(v, 1);
+        assert(SimdCount(v, 1) == v.Size() && SimdFind(v, 0) == v.Size());
+        v[v.Size() - 1] = 0;
+        assert(SimdFind(v, 0) == v.Size() - 1);
+
+        // Удаление со всеми вариантами сравнения, в том числе NaN: сравнение с ним всегда ложно
+        Vector<double> d(4);
+        d[0] = 1.0;
+        d[1] = std::numeric_limits<double>::quiet_NaN();
+        d[2] = 2.0;
+        d[3] = 3.0;
+        assert(SimdEraseIf(d, SIMD_LESS, 2.0) == 1 && d.Size() == 3 && std::isnan(d[0]));
+        assert(SimdEraseIf(d, SIMD_NOT_EQUAL, 2.0) == 2 && d.Size() == 1 && d[0] == 2.0);
+        assert(SimdEraseIf(d, SIMD_LESS_EQUAL, 1.0) == 0 && SimdEraseIf(d, SIMD_GREATER, 1.0) == 1 && d.Size() == 0);
+
+        // Указатели на участок массива, например столбец SoaVector
+        SoaVector<float, int> soa;
+        for (int i = 0; i < 100; ++i)
+        {
+            soa.EmplaceBack(static_cast<float>(i), -i);
+        }
+        const auto xs = soa.Column<0>();
+        assert(SimdSum(xs.Data(), xs.Size()) == 4950.0f);
+        assert(SimdMinMax(soa.Column<1>().Data(), soa.Size()) == std::make_pair(-99, 0));
+    }
+}
+
+void Test26()
+{
+    const auto is_aligned = [](const void* p, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+    };
+    {
+        // Буфер выровнен по строке кэша при любом росте, а округление размера становится вместимостью
+        AlignedVector<float> v;
+        for (int i = 0; i < 1000; ++i)
+        {
+            v.PushBack(static_cast<float>(i));
+            assert(is_aligned(v.begin(), CACHE_LINE_SIZE));
+        }
+        assert(v.Capacity() % (CACHE_LINE_SIZE / sizeof(float)) == 0);
+        assert(SimdSum(v) == 999 * 1000 / 2);
+        v.ShrinkToFit();
+        assert(is_aligned(v.begin(), CACHE_LINE_SIZE) && v.Capacity() == 1008);
+
+        AlignedVector<float> copy(v);
+        assert(is_aligned(copy.begin(), CACHE_LINE_SIZE) && std::equal(v.begin(), v.end(), copy.begin()));
+    }
+    {
+        // Тип с выравниванием больше alignof(std::max_align_t)
+        struct alignas(256) Block
+        {
+            char data[256];
+        };
+        static_assert(std::is_same_v<AlignedAllocator<Block>, AlignedAllocator<Block, 256>>);
+        Vector<Block, AlignedAllocator<Block>> blocks(3);
+        blocks.Resize(100);
+        assert(is_aligned(blocks.begin(), 256));
+
+        Vector<double, AlignedAllocator<double, 4096>> page(10);
+        assert(is_aligned(page.begin(), 4096) && page.Capacity() == 4096 / sizeof(double));
+    }
+    {
+        // Счётчики по строке кэша на каждый: потоки не делят строки
+        static_assert(sizeof(CacheAligned<uint64_t>) == CACHE_LINE_SIZE && alignof(CacheAligned<uint64_t>) == CACHE_LINE_SIZE);
+        AlignedVector<CacheAligned<uint64_t>> counters(4);
+        for (size_t i = 0; i < counters.Size(); ++i)
+        {
+            assert(is_aligned(&counters[i], CACHE_LINE_SIZE));
+            *counters[i] += i;
+        }
+        counters.PushBack(7);
+        assert(*counters[3] == 3 && counters[4].value == 7);
+
+        // 24-байтные элементы выравниваются по 32 байтам и не пересекают строки кэша
+        struct Triple
+        {
+            uint64_t a, b, c;
+        };
+        static_assert(sizeof(CacheFitted<Triple>) == 32 && sizeof(CacheFitted<char[100]>) == 128);
+        static_assert(sizeof(CacheFitted<uint32_t>) == 4);
+        AlignedVector<CacheFitted<Triple>> triples(10);
+        for (const auto& t : triples)
+        {
+            const uintptr_t begin = reinterpret_cast<uintptr_t>(&t);
+            assert(begin / CACHE_LINE_SIZE == (begin + sizeof(Triple) - 1) / CACHE_LINE_SIZE);
+        }
+
+        // Нетривиальный элемент
+        Vector<CacheAligned<std::string>> strings;
+        strings.EmplaceBack(std::in_place, 3, 'x');
+        strings.PushBack(std::string("long string without small buffer optimization"));
+        strings.Insert(strings.begin(), std::string("y"));
+        assert(*strings[0] == "y" && *strings[1] == "xxx" && strings[2]->size() > 40);
+        static_assert(IsTriviallyRelocatableV<CacheAligned<int>> && !IsTriviallyRelocatableV<CacheAligned<std::string>>);
+    }
+}
+
+struct StatsTestTag
+{
+    static constexpr const char* NAME = "test27.numbers";
+};
+
+struct StatsTestOtherTag
+{
+    static constexpr const char* NAME = "test27.other";
+};
+
+void Test27()
+{
+    // Политика без статистики не добавляет состояния
+    static_assert(sizeof(TrackedVector<int, StatsTestTag>) == sizeof(Vector<int>));
+
+    const auto find = [](const char* tag) {
+        for (const VectorStatsSnapshot& s : VectorStatsRegistry::Instance().Snapshot())
+        {
+            if (std::string(s.tag) == tag)
+            {
+                return s;
+            }
+        }
+        assert(false && "Tag is not registered");
+        return VectorStatsSnapshot{};
+    };
+
+    {
+        TrackedVector<int, StatsTestTag> v;
+        for (int i = 0; i < 100; ++i)
+        {
+            v.PushBack(i);
+        }
+        // Вместимости 1, 2, 4, ..., 128; в новые буферы переносились 1 + 2 + ... + 64 элемента
+        VectorStatsSnapshot s = find(StatsTestTag::NAME);
+        assert(s.allocations == 8 && s.allocated_bytes == 255 * sizeof(int) && s.peak_capacity_bytes == 128 * sizeof(int));
+        assert(s.reallocations == 7 && s.relocated_bytes == 127 * sizeof(int));
+        assert(s.shifts == 0);
+
+        v.Insert(v.begin(), -1);
+        v.Erase(v.begin() + 1, v.begin() + 11);
+        s = find(StatsTestTag::NAME);
+        assert(s.shifts == 2 && s.shifted_bytes == (100 + 90) * sizeof(int) && s.allocations == 8);
+
+        v.Reserve(1000);
+        TrackedVector<int, StatsTestTag> copy(v);
+        s = find(StatsTestTag::NAME);
+        assert(s.allocations == 10 && s.reallocations == 8 && s.relocated_bytes == (127 + 91) * sizeof(int));
+        assert(s.peak_capacity_bytes == 1000 * sizeof(int));
+
+        TrackedVector<std::string, StatsTestOtherTag> strings(3);
+        strings.Insert(strings.begin() + 1, "x");
+        s = find(StatsTestOtherTag::NAME);
+        assert(s.allocations == 2 && s.reallocations == 1 && s.relocated_bytes == 3 * sizeof(std::string));
+    }
+
+    // Теги упорядочены по выделенным байтам и выводятся по строке
+    const Vector<VectorStatsSnapshot> snapshot = VectorStatsRegistry::Instance().Snapshot();
+    assert(std::is_sorted(snapshot.begin(), snapshot.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.allocated_bytes > rhs.allocated_bytes;
+    }));
+    std::ostringstream out;
+    VectorStatsRegistry::Instance().Dump(out);
+    assert(out.str().find("test27.numbers: allocations=10 ") != std::string::npos);
+
+    VectorStatsRegistry::Instance().Reset();
+    assert(find(StatsTestTag::NAME).allocations == 0 && find(StatsTestOtherTag::NAME).peak_capacity_bytes == 0);
+}
+
+void Test28()
+{
+    {
+        // Случайные правки сравниваются с std::vector
+        GapVector<int> v;
+        std::vector<int> model;
+        unsigned seed = 12345;
+        const auto next = [&seed](size_t bound) {
+            seed = seed * 1103515245 + 12345;
+            return static_cast<size_t>(seed >> 8) % bound;
+        };
+        size_t cursor = 0;
+        for (int i = 0; i < 5000; ++i)
+        {
+            const size_t op = next(10);
+            if (op < 5 || model.empty())
+            {
+                v.Insert(cursor, i);
+                model.insert(model.begin() + cursor, i);
+                ++cursor;
+            }
+            else if (op < 7)
+            {
+                const size_t count = std::min(next(3) + 1, model.size() - std::min(cursor, model.size() - 1));
+                const size_t first = std::min(cursor, model.size() - count);
+                v.Erase(first, first + count);
+                model.erase(model.begin() + first, model.begin() + first + count);
+                cursor = first;
+            }
+            else if (op < 8)
+            {
+                v.PopBack();
+                model.pop_back();
+                cursor = std::min(cursor, model.size());
+            }
+            else
+            {
+                cursor = next(model.size() + 1);
+            }
+            assert(v.Size() == model.size());
+        }
+        for (size_t i = 0; i < model.size(); ++i)
+        {
+            assert(v[i] == model[i]);
+        }
+        const size_t gap = v.GapPosition();
+        assert(std::equal(v.begin(), v.end(), model.begin(), model.end()) && v.GapPosition() == gap);
+        std::sort(v.begin(), v.end());
+        std::sort(model.begin(), model.end());
+        assert(std::equal(v.begin(), v.end(), model.begin(), model.end()));
+
+        // iterator преобразуется в const_iterator, итераторы разной константности сравнимы
+        GapVector<int>::const_iterator it = v.begin() + 1;
+        assert(it == v.cbegin() + 1 && v.begin() < it && v.end() - it == static_cast<ptrdiff_t>(model.size() - 1));
+        *v.begin() = model[0] - 1;
+        model[0] -= 1;
+
+        v.MoveGap(v.Size());
+        const GapVector<int> copy(v);
+        assert(copy.Size() == v.Size() && copy.Capacity() == copy.Size() && copy[0] == model[0]);
+
+        // Константный вектор обходится по индексу, разрыв остаётся на месте
+        v.MoveGap(v.Size() / 2);
+        const GapVector<int>& const_v = v;
+        assert(std::equal(const_v.begin(), const_v.end(), model.begin(), model.end()));
+        assert(std::accumulate(const_v.cbegin(), const_v.cend(), 0LL) == std::accumulate(model.begin(), model.end(), 0LL));
+        assert(const_v.end() - const_v.begin() == static_cast<ptrdiff_t>(model.size()) && const_v.begin()[3] == model[3]);
+        assert(v.GapPosition() == v.Size() / 2);
+        try
+        {
+            (void)const_v.Data();
+            assert(false && "Exception is expected");
+        }
+        catch (const std::logic_error&)
+        {
+        }
+        v.MoveGap(v.Size());
+        assert(const_v.Data()[v.Size() - 1] == model.back() && copy.Data()[0] == model[0]);
+    }
+    Obj::ResetCounters();
+    {
+        // Серия вставок и удалений у курсора не сдвигает хвост
+        const int SIZE = 1000;
+        GapVector<Obj> v;
+        v.Reserve(2 * SIZE);
+        for (int i = 0; i < SIZE; ++i)
+        {
+            v.EmplaceBack(i);
+        }
+        v.MoveGap(SIZE / 2);
+        assert(Obj::num_moved == SIZE / 2);
+        for (int i = 0; i < SIZE / 2; ++i)
+        {
+            v.Emplace(SIZE / 2 + i, -i);
+        }
+        // Удаление слева от разрыва (backspace) и справа от него (delete)
+        v.Erase(SIZE - 1);
+        v.Erase(SIZE - 1);
+        assert(Obj::num_moved == SIZE / 2 && v.Size() == SIZE + SIZE / 2 - 2);
+        assert(v[SIZE / 2 - 1].id == SIZE / 2 - 1 && v[SIZE - 2].id == -(SIZE / 2 - 2) && v[SIZE - 1].id == SIZE / 2 + 1);
+
+        // Аргумент ссылается на элемент, который перемещается при переносе разрыва или росте
+        v.Insert(0, v[v.Size() - 1]);
+        assert(v[0].id == SIZE - 1);
+        GapVector<std::string> strings;
+        strings.PushBack("long string without small buffer optimization");
+        strings.Insert(0, strings[0]);
+        strings.Insert(1, strings[1]);
+        assert(strings.Size() == 3 && strings[0] == strings[2] && strings[1] == strings[2]);
+
+        GapVector<Obj> moved(std::move(v));
+        assert(v.Size() == 0 && moved.Size() == SIZE + SIZE / 2 - 1);
+
+        // Удаление последнего элемента не переносит разрыв, а свободные слоты в конце буфера
+        // снова присоединяются к разрыву, когда за ним не остаётся элементов
+        moved.MoveGap(10);
+        const size_t gap_size = moved.GapSize();
+        const int moved_before = Obj::num_moved;
+        const int last_id = moved[moved.Size() - 2].id;
+        moved.PopBack();
+        assert(Obj::num_moved == moved_before && moved.GapPosition() == 10 && moved.GapSize() == gap_size);
+        assert(moved.Size() == SIZE + SIZE / 2 - 2 && moved[moved.Size() - 1].id == last_id);
+        moved.Emplace(10, 42);
+        moved.Emplace(11, 43);
+        assert(moved[10].id == 42 && moved[11].id == 43 && moved[moved.Size() - 1].id == last_id);
+        moved.Erase(12, moved.Size());
+        assert(moved.Size() == 12 && moved.GapPosition() == 12 && moved.GapSize() == moved.Capacity() - 12);
+        while (moved.GapSize() > 0)
+        {
+            moved.PushBack(Obj(7));
+        }
+        moved.MoveGap(5);
+        const int id_at_gap = moved[5].id;
+        moved.PopBack();
+        moved.PushBack(Obj(8));
+        assert(moved.Size() == moved.Capacity() && moved[moved.Size() - 1].id == 8 && moved[5].id == id_at_gap);
+        assert(moved.Data()[moved.Size() - 2].id == 7);
+        moved.Clear();
+        assert(moved.Size() == 0 && moved.GapSize() == moved.Capacity());
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test29()
+{
+    {
+        // Случайные операции с обоих краёв и в середине сравниваются с std::deque
+        DeVector<int> v;
+        std::deque<int> model;
+        unsigned seed = 54321;
+        const auto next = [&seed](size_t bound) {
+            seed = seed * 1103515245 + 12345;
+            return static_cast<size_t>(seed >> 8) % bound;
+        };
+        for (int i = 0; i < 5000; ++i)
+        {
+            const size_t op = next(12);
+            if (op < 3)
+            {
+                v.PushFront(i);
+                model.push_front(i);
+            }
+            else if (op < 6)
+            {
+                v.PushBack(i);
+                model.push_back(i);
+            }
+            else if (op < 8 && !model.empty())
+            {
+                const size_t index = next(model.size() + 1);
+                assert(*v.Insert(v.begin() + index, i) == i);
+                model.insert(model.begin() + index, i);
+            }
+            else if (op < 9 && !model.empty())
+            {
+                v.PopFront();
+                model.pop_front();
+            }
+            else if (op < 10 && !model.empty())
+            {
+                v.PopBack();
+                model.pop_back();
+            }
+            else if (!model.empty())
+            {
+                const size_t first = next(model.size());
+                const size_t last = std::min(model.size(), first + next(3) + 1);
+                v.Erase(v.begin() + first, v.begin() + last);
+                model.erase(model.begin() + first, model.begin() + last);
+            }
+            assert(v.Size() == model.size() && v.FreeFront() + v.Size() + v.FreeBack() == v.Capacity());
+        }
+        assert(std::equal(v.begin(), v.end(), model.begin(), model.end()));
+
+        const DeVector<int> copy(v);
+        assert(copy.Size() == v.Size() && copy.Capacity() == copy.Size() && std::equal(copy.cbegin(), copy.cend(), v.begin()));
+    }
+    {
+        // Очередь (PushBack + PopFront) не растёт неограниченно: элементы сдвигаются к середине буфера
+        DeVector<int> queue;
+        for (int i = 0; i < 8; ++i)
+        {
+            queue.PushBack(i);
+        }
+        const size_t capacity = queue.Capacity();
+        for (int i = 8; i < 10000; ++i)
+        {
+            queue.PushBack(i);
+            assert(queue.begin()[0] == i - 8);
+            queue.PopFront();
+        }
+        assert(queue.Capacity() <= 4 * capacity && queue.Size() == 8 && queue[0] == 9992);
+
+        // Серия PushFront оставляет запас перед элементами
+        DeVector<int> stack;
+        for (int i = 0; i < 1000; ++i)
+        {
+            stack.PushFront(i);
+        }
+        assert(stack[0] == 999 && stack[999] == 0 && stack.FreeFront() >= stack.FreeBack());
+    }
+    Obj::ResetCounters();
+    {
+        // Вставка и удаление сдвигают меньшую часть
+        const int SIZE = 100;
+        DeVector<Obj> v;
+        v.Reserve(4 * SIZE);
+        for (int i = 0; i < SIZE; ++i)
+        {
+            v.EmplaceBack(i);
+        }
+        for (int i = 0; i < SIZE; ++i)
+        {
+            v.EmplaceFront(-i - 1);
+        }
+        assert(v.Capacity() == 4 * SIZE && v[0].id == -SIZE && v[2 * SIZE - 1].id == SIZE - 1);
+
+        const int moved_before = Obj::num_moved + Obj::num_move_assigned;
+        v.Emplace(v.begin() + 10, 1000);
+        assert(Obj::num_moved + Obj::num_move_assigned - moved_before <= 12 && v[10].id == 1000 && v[9].id == -SIZE + 9);
+        v.Erase(v.end() - 10);
+        assert(Obj::num_moved + Obj::num_move_assigned - moved_before <= 24 && v[v.Size() - 9].id == SIZE - 9);
+        v.Erase(v.begin() + 3, v.begin() + 5);
+        assert(v.Size() == 2 * SIZE - 2 && v[2].id == -SIZE + 2 && v[3].id == -SIZE + 5);
+
+        // Аргумент ссылается на элемент, который сдвигается или переносится при росте
+        v.Insert(v.begin(), v[v.Size() - 1]);
+        assert(v[0].id == SIZE - 1);
+        DeVector<std::string> strings;
+        strings.PushBack("long string without small buffer optimization");
+        strings.PushFront(strings[0]);
+        strings.PushBack(strings[0]);
+        strings.Insert(strings.begin() + 1, strings[2]);
+        assert(strings.Size() == 4 && strings[0] == strings[3] && strings[1] == strings[2]);
+
+        DeVector<Obj> moved(std::move(v));
+        assert(v.Size() == 0 && moved.Size() == 2 * SIZE - 1);
+        moved.PopBack();
+        moved.PopFront();
+        moved.Clear();
+        assert(moved.Size() == 0 && moved.FreeFront() == moved.Capacity() / 2);
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test30()
+{
+    Obj::ResetCounters();
+    {
+        const int SIZE = 100;
+        Vector<Obj> items;
+        for (int i = 0; i < SIZE; ++i)
+        {
+            items.EmplaceBack(i);
+        }
+        const CowVector<Obj> table(std::move(items));
+        assert(table.Size() == SIZE && table.UseCount() == 1);
+
+        // Копии разделяют буфер и ничего не копируют
+        const int copied_before = Obj::num_copied;
+        CowVector<Obj> snapshot = table;
+        CowVector<Obj> other_snapshot = snapshot;
+        assert(table.UseCount() == 3 && Obj::num_copied == copied_before);
+        assert(snapshot.cbegin() == table.begin() && snapshot[SIZE - 1].id == SIZE - 1);
+
+        // Первое изменение копирует буфер, следующие - нет
+        snapshot.PushBack(snapshot[0]);
+        assert(Obj::num_copied == copied_before + SIZE + 1);
+        assert(table.UseCount() == 2 && snapshot.UseCount() == 1 && snapshot.cbegin() != table.begin());
+        snapshot[0].id = -1;
+        snapshot.Insert(1, Obj(1000));
+        snapshot.Erase(2);
+        assert(Obj::num_copied == copied_before + SIZE + 1);
+        assert(snapshot.Size() == SIZE + 1 && snapshot[0].id == -1 && snapshot[1].id == 1000 && snapshot[2].id == 2);
+        assert(snapshot[SIZE].id == 0 && table[0].id == 0 && std::as_const(other_snapshot)[1].id == 1);
+
+        // Очистка разделяемой копии не копирует буфер
+        other_snapshot.Clear();
+        assert(other_snapshot.Size() == 0 && other_snapshot.UseCount() == 0 && table.UseCount() == 1);
+        other_snapshot.EmplaceBack(7);
+        assert(other_snapshot.Size() == 1 && other_snapshot[0].id == 7);
+
+        CowVector<Obj> moved(std::move(snapshot));
+        assert(snapshot.Size() == 0 && moved.Size() == SIZE + 1);
+        moved = table;
+        assert(table.UseCount() == 2 && moved.Size() == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Читатели в разных потоках копируют и отпускают общий снимок, пока писатель публикует новые
+        Vector<std::string> lines;
+        for (int i = 0; i < 100; ++i)
+        {
+            lines.EmplaceBack("long string without small buffer optimization");
+        }
+        CowVector<std::string> published(std::move(lines));
+        std::mutex mutex;
+        std::atomic<bool> done{ false };
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&] {
+                while (!done.load())
+                {
+                    CowVector<std::string> local;
+                    {
+                        std::lock_guard lock(mutex);
+                        local = published;
+                    }
+                    assert(local.Size() >= 100 && local.cbegin()[0] == local.cbegin()[local.Size() - 1]);
+                    local.PushBack(local.cbegin()[0]);
+                }
+            });
+        }
+        for (int i = 0; i < 200; ++i)
+        {
+            CowVector<std::string> next;
+            {
+                std::lock_guard lock(mutex);
+                next = published;
+            }
+            next.PushBack(next.cbegin()[0]);
+            std::lock_guard lock(mutex);
+            published = std::move(next);
+        }
+        done = true;
+        for (std::thread& reader : readers)
+        {
+            reader.join();
+        }
+        assert(published.Size() == 300 && published.UseCount() == 1);
     }
 }
 
@@ -697,7 +2688,30 @@ int main()
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
     }
     catch (const std::exception& e)
     {
@@ -0,0 +1,389 @@
+#pragma once
+#include "vector.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+// Заголовок файла MappedVector. Хранится в начале файла, за ним следуют элементы
+struct MappedVectorHeader
+{
+    static constexpr uint64_t MAGIC = 0x524f544345564d41;  // "AMVECTOR"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t element_size;
+    uint64_t size;
+    uint64_t capacity;
+};
+
+// Сырая память, отображённая на файл: аналог RawMemory для MappedVector.
+// Файл состоит из заголовка и буфера на capacity элементов. Размер буфера меняется
+// через ftruncate и mremap, содержимое при этом не копируется.
+template <typename T>
+class MappedMemory
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be stored in a file");
+
+public:
+    // Смещение первого элемента от начала файла
+    static constexpr size_t DATA_OFFSET = (sizeof(MappedVectorHeader) + std::max<size_t>(alignof(T), 64) - 1)
+        / std::max<size_t>(alignof(T), 64) * std::max<size_t>(alignof(T), 64);
+
+    MappedMemory() = default;
+
+    // Открывает файл path, создавая его при отсутствии.
+    // Выбрасывает std::system_error при ошибке ввода-вывода и std::runtime_error,
+    // если файл создан не MappedVector или для элементов другого размера
+    explicit MappedMemory(const std::string& path)
+    {
+        fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0)
+        {
+            ThrowSystemError("open " + path);
+        }
+
+        try
+        {
+            struct stat st;
+            if (fstat(fd_, &st) != 0)
+            {
+                ThrowSystemError("fstat " + path);
+            }
+
+            if (st.st_size == 0)
+            {
+                Map(0);
+                *Header() = MappedVectorHeader{ MappedVectorHeader::MAGIC, MappedVectorHeader::VERSION, sizeof(T), 0, 0 };
+                return;
+            }
+
+            if (static_cast<size_t>(st.st_size) < DATA_OFFSET)
+            {
+                throw std::runtime_error(path + ": file is too small to be a MappedVector");
+            }
+            MapExisting(static_cast<size_t>(st.st_size));
+
+            const MappedVectorHeader& header = *Header();
+            if (header.magic != MappedVectorHeader::MAGIC || header.version != MappedVectorHeader::VERSION)
+            {
+                throw std::runtime_error(path + ": not a MappedVector file");
+            }
+            if (header.element_size != sizeof(T))
+            {
+                throw std::runtime_error(path + ": element size mismatch");
+            }
+            // Вместимость проверяется до умножения: иначе переполнение позволило бы повреждённому заголовку пройти проверку
+            if (header.size > header.capacity || header.capacity > MAX_CAPACITY
+                || DATA_OFFSET + header.capacity * sizeof(T) > static_cast<size_t>(st.st_size))
+            {
+                throw std::runtime_error(path + ": corrupted header");
+            }
+        }
+        catch (...)
+        {
+            Release();
+            throw;
+        }
+    }
+
+    MappedMemory(const MappedMemory&) = delete;
+
+    MappedMemory& operator=(const MappedMemory&) = delete;
+
+    MappedMemory(MappedMemory&& other) noexcept
+    {
+        Swap(other);
+    }
+
+    MappedMemory& operator=(MappedMemory&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            Release();
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    ~MappedMemory()
+    {
+        Release();
+    }
+
+    void Swap(MappedMemory& other) noexcept
+    {
+        std::swap(fd_, other.fd_);
+        std::swap(mapping_, other.mapping_);
+        std::swap(length_, other.length_);
+    }
+
+    // Изменяет вместимость файла. Если изменить размер не удалось, выбрасывается std::system_error,
+    // а отображение остаётся прежним
+    void Reallocate(size_t new_capacity)
+    {
+        if (fd_ < 0)
+        {
+            throw std::logic_error("MappedMemory: no file is open");
+        }
+        if (new_capacity > MAX_CAPACITY)
+        {
+            throw std::bad_array_new_length();
+        }
+        Map(new_capacity);
+        Header()->capacity = new_capacity;
+    }
+
+    // Сбрасывает изменения на диск
+    void Sync()
+    {
+        if (mapping_ != nullptr && msync(mapping_, length_, MS_SYNC) != 0)
+        {
+            ThrowSystemError("msync");
+        }
+    }
+
+    MappedVectorHeader* Header() noexcept
+    {
+        return static_cast<MappedVectorHeader*>(mapping_);
+    }
+
+    const MappedVectorHeader* Header() const noexcept
+    {
+        return static_cast<const MappedVectorHeader*>(mapping_);
+    }
+
+    T* GetAddress() noexcept
+    {
+        return mapping_ != nullptr ? reinterpret_cast<T*>(static_cast<char*>(mapping_) + DATA_OFFSET) : nullptr;
+    }
+
+    const T* GetAddress() const noexcept
+    {
+        return const_cast<MappedMemory&>(*this).GetAddress();
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return mapping_ != nullptr ? Header()->capacity : 0;
+    }
+
+private:
+    // Наибольшая вместимость, при которой размер файла не переполняет size_t
+    static constexpr size_t MAX_CAPACITY = (SIZE_MAX - DATA_OFFSET) / sizeof(T);
+
+    [[noreturn]] static void ThrowSystemError(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void MapExisting(size_t length)
+    {
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED)
+        {
+            ThrowSystemError("mmap");
+        }
+        mapping_ = p;
+        length_ = length;
+    }
+
+    // Устанавливает размер файла под capacity элементов и отображает его целиком
+    void Map(size_t capacity)
+    {
+        const size_t length = DATA_OFFSET + capacity * sizeof(T);
+        if (ftruncate(fd_, static_cast<off_t>(length)) != 0)
+        {
+            ThrowSystemError("ftruncate");
+        }
+
+        if (mapping_ == nullptr)
+        {
+            MapExisting(length);
+            return;
+        }
+
+        void* p = mremap(mapping_, length_, length, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED)
+        {
+            const int error = errno;
+            // Возвращаем файлу прежний размер, чтобы он соответствовал отображению
+            (void)ftruncate(fd_, static_cast<off_t>(length_));
+            errno = error;
+            ThrowSystemError("mremap");
+        }
+        mapping_ = p;
+        length_ = length;
+    }
+
+    void Release() noexcept
+    {
+        if (mapping_ != nullptr)
+        {
+            munmap(mapping_, length_);
+            mapping_ = nullptr;
+            length_ = 0;
+        }
+        if (fd_ >= 0)
+        {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_ = -1;
+    void* mapping_ = nullptr;
+    size_t length_ = 0;
+};
+
+// Вектор тривиально копируемых элементов, хранящийся в отображённом на память файле.
+// Размер и вместимость записаны в заголовке файла, поэтому после перезапуска процесса
+// содержимое доступно сразу после открытия файла, без чтения и копирования.
+// Изменения попадают в файл через страничный кеш; Sync() дожидается их записи на диск.
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+class MappedVector
+{
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // Открывает вектор, хранящийся в файле path, или создаёт пустой, если файла нет
+    explicit MappedVector(const std::string& path) : data_(path) {}
+
+    MappedVector(MappedVector&& other) noexcept = default;
+
+    MappedVector& operator=(MappedVector&& rhs) noexcept = default;
+
+    void Swap(MappedVector& other) noexcept
+    {
+        data_.Swap(other.data_);
+    }
+
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity > data_.Capacity())
+        {
+            data_.Reallocate(new_capacity);
+        }
+    }
+
+    void Resize(size_t new_size)
+    {
+        Reserve(new_size);
+        if (new_size > Size())
+        {
+            std::uninitialized_value_construct_n(end(), new_size - Size());
+        }
+        SetSize(new_size);
+    }
+
+    void PushBack(const T& value)
+    {
+        EmplaceBack(value);
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        // Элемент создаётся до возможного переотображения: аргументы могут ссылаться на элементы вектора
+        T value(std::forward<Args>(args)...);
+        if (Size() == Capacity())
+        {
+            data_.Reallocate(std::max(GrowthPolicy::NextCapacity(Capacity(), sizeof(T)), Size() + 1));
+        }
+        T* slot = new (end()) T(value);
+        // Размер в заголовке увеличивается только после записи элемента
+        SetSize(Size() + 1);
+        return *slot;
+    }
+
+    void PopBack() noexcept
+    {
+        if (Size() > 0)
+        {
+            SetSize(Size() - 1);
+        }
+    }
+
+    void Clear() noexcept
+    {
+        SetSize(0);
+    }
+
+    void Sync()
+    {
+        data_.Sync();
+    }
+
+    iterator begin() noexcept
+    {
+        return data_.GetAddress();
+    }
+
+    iterator end() noexcept
+    {
+        return begin() + Size();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data_.GetAddress();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return begin() + Size();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    size_t Size() const noexcept
+    {
+        return data_.Header() != nullptr ? data_.Header()->size : 0;
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return data_.Capacity();
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        return const_cast<MappedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept
+    {
+        assert(index < Size());
+        return begin()[index];
+    }
+
+private:
+    // У перемещённого вектора нет отображения, и его размер всегда нулевой
+    void SetSize(size_t size) noexcept
+    {
+        if (data_.Header() == nullptr)
+        {
+            assert(size == 0);
+            return;
+        }
+        data_.Header()->size = size;
+    }
+
+    MappedMemory<T> data_;
+};
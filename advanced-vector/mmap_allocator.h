@@ -0,0 +1,229 @@
+#pragma once
+#include "vector.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Режимы отображения крупных буферов MmapAllocator (битовые флаги)
+enum MmapFlags : unsigned
+{
+    MMAP_DEFAULT = 0,
+    // madvise(MADV_HUGEPAGE): ядро подкладывает под буфер прозрачные huge pages (THP)
+    MMAP_TRANSPARENT_HUGE_PAGES = 1u << 0,
+    // MAP_HUGETLB: буфер отображается на зарезервированные huge pages (hugetlbfs).
+    // Если свободных huge pages нет, используется обычное отображение
+    MMAP_HUGETLB = 1u << 1,
+    // Страницы буфера выделяются сразу при отображении, а не при первом обращении
+    MMAP_POPULATE = 1u << 2,
+};
+
+namespace detail
+{
+    inline size_t PageSize() noexcept
+    {
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    // Округляет value вверх до кратного alignment (степени двойки)
+    inline constexpr uintptr_t RoundUp(uintptr_t value, size_t alignment) noexcept
+    {
+        return (value + alignment - 1) & ~(uintptr_t{ alignment } - 1);
+    }
+}  // namespace detail
+
+// Аллокатор для очень больших векторов (Linux).
+// Буферы меньше Threshold байт выделяются через operator new, крупные - отображаются через mmap.
+// Размер отображения округляется до huge page (2 МиБ), и через usable_size этот запас становится вместимостью.
+// Крупные буферы растут через mremap без копирования страниц, а discard освобождает страницы
+// неиспользуемой части буфера через madvise(MADV_DONTNEED), когда вектор уменьшается или очищается.
+template <typename T, size_t Threshold = size_t{ 2 } << 20, unsigned Flags = MMAP_TRANSPARENT_HUGE_PAGES>
+struct MmapAllocator
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr size_t HUGE_PAGE_SIZE = size_t{ 2 } << 20;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = MmapAllocator<U, Threshold, Flags>;
+    };
+
+    MmapAllocator() noexcept = default;
+
+    template <typename U>
+    MmapAllocator(const MmapAllocator<U, Threshold, Flags>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        if (n > MAX_COUNT)
+        {
+            throw std::bad_array_new_length();
+        }
+        if (!IsMapped(n))
+        {
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+        return static_cast<T*>(Map(MappedLength(n)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        if (!IsMapped(n))
+        {
+            operator delete(p);
+            return;
+        }
+        munmap(p, MappedLength(n));
+    }
+
+    // Отображённый буфер изменяет размер через mremap: страницы переносятся в новое место
+    // без копирования, а при наличии свободного адресного пространства буфер растёт на месте.
+    // В остальных случаях содержимое копируется в новый блок
+    T* reallocate(T* p, size_t old_n, size_t new_n)
+    {
+        if (new_n > MAX_COUNT)
+        {
+            throw std::bad_array_new_length();
+        }
+
+        if constexpr ((Flags & MMAP_HUGETLB) == 0)
+        {
+            if (IsMapped(old_n) && IsMapped(new_n))
+            {
+                const size_t old_length = MappedLength(old_n);
+                const size_t new_length = MappedLength(new_n);
+                void* new_p = mremap(p, old_length, new_length, MREMAP_MAYMOVE);
+                if (new_p == MAP_FAILED)
+                {
+                    throw std::bad_alloc();
+                }
+                if constexpr ((Flags & MMAP_POPULATE) != 0)
+                {
+                    if (new_length > old_length)
+                    {
+                        Populate(static_cast<char*>(new_p) + old_length, new_length - old_length);
+                    }
+                }
+                return static_cast<T*>(new_p);
+            }
+        }
+
+        T* new_p = allocate(new_n);
+        std::memcpy(static_cast<void*>(new_p), static_cast<const void*>(p), std::min(old_n, new_n) * sizeof(T));
+        deallocate(p, old_n);
+        return new_p;
+    }
+
+    size_t usable_size(T* /*p*/, size_t n) const noexcept
+    {
+        return IsMapped(n) ? MappedLength(n) / sizeof(T) : n;
+    }
+
+    // Возвращает системе страницы, целиком занятые элементами [first, n) отображённого буфера.
+    // При следующем обращении они будут выделены заново и заполнены нулями
+    void discard(T* p, size_t n, size_t first) noexcept
+    {
+        if (!IsMapped(n))
+        {
+            return;
+        }
+        const uintptr_t begin = detail::RoundUp(reinterpret_cast<uintptr_t>(p + first), detail::PageSize());
+        const uintptr_t end = reinterpret_cast<uintptr_t>(p) + MappedLength(n);
+        if (begin < end)
+        {
+            madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const MmapAllocator<U, Threshold, Flags>&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const MmapAllocator<U, Threshold, Flags>&) const noexcept
+    {
+        return false;
+    }
+
+private:
+    // Наибольшее число элементов, для которого длина отображения, округлённая до huge page,
+    // вместе с запасом на выравнивание (Map) не переполняет size_t
+    static constexpr size_t MAX_COUNT = (SIZE_MAX - 2 * HUGE_PAGE_SIZE + 1) / sizeof(T);
+
+    static bool IsMapped(size_t n) noexcept
+    {
+        return n * sizeof(T) >= Threshold;
+    }
+
+    static size_t MappedLength(size_t n) noexcept
+    {
+        return detail::RoundUp(n * sizeof(T), HUGE_PAGE_SIZE);
+    }
+
+    static void* Map(size_t length)
+    {
+        if constexpr ((Flags & MMAP_HUGETLB) != 0)
+        {
+            const int populate = (Flags & MMAP_POPULATE) != 0 ? MAP_POPULATE : 0;
+            void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | populate, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                return p;
+            }
+        }
+
+        // Отображение с запасом в одну huge page, чтобы выровнять буфер по её границе:
+        // иначе ядро не сможет подложить huge pages под начало и конец буфера
+        const size_t padded_length = length + HUGE_PAGE_SIZE;
+        void* raw = mmap(nullptr, padded_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        const uintptr_t raw_begin = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t begin = detail::RoundUp(raw_begin, HUGE_PAGE_SIZE);
+        if (begin > raw_begin)
+        {
+            munmap(raw, begin - raw_begin);
+        }
+        if (raw_begin + padded_length > begin + length)
+        {
+            munmap(reinterpret_cast<void*>(begin + length), raw_begin + padded_length - begin - length);
+        }
+
+        void* p = reinterpret_cast<void*>(begin);
+        if constexpr ((Flags & MMAP_TRANSPARENT_HUGE_PAGES) != 0)
+        {
+            madvise(p, length, MADV_HUGEPAGE);
+        }
+        if constexpr ((Flags & MMAP_POPULATE) != 0)
+        {
+            Populate(p, length);
+        }
+        return p;
+    }
+
+    // Заранее выделяет физические страницы диапазона.
+    // После madvise(MADV_HUGEPAGE) это делается отдельно от mmap, чтобы страницы сразу были большими
+    static void Populate(void* p, size_t length) noexcept
+    {
+#if defined(MADV_POPULATE_WRITE)
+        if (madvise(p, length, MADV_POPULATE_WRITE) == 0)
+        {
+            return;
+        }
+#endif
+        const size_t page_size = detail::PageSize();
+        volatile char* bytes = static_cast<char*>(p);
+        for (size_t offset = 0; offset < length; offset += page_size)
+        {
+            bytes[offset] = 0;
+        }
+    }
+};
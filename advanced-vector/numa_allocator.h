@@ -0,0 +1,237 @@
+#pragma once
+#include "mmap_allocator.h"
+
+#include <sys/syscall.h>
+
+#include <cerrno>
+#include <system_error>
+
+// Размещение буфера NumaAllocator по узлам NUMA (Linux)
+enum NumaPlacement
+{
+    // Страницы выделяются на узле потока, который первым к ним обращается (first-touch).
+    // Если каждый поток заполняет свою часть вектора, части окажутся на узлах этих потоков
+    NUMA_LOCAL,
+    // Страницы чередуются между узлами маски
+    NUMA_INTERLEAVE,
+    // Страницы выделяются только на узлах маски
+    NUMA_BIND,
+    // Буфер делится на равные части по числу узлов маски, i-я часть закрепляется за i-м узлом маски
+    NUMA_PARTITIONED,
+};
+
+namespace detail
+{
+    // Значения из <numaif.h>, чтобы не зависеть от libnuma
+    inline constexpr int NUMA_MPOL_BIND = 2;
+    inline constexpr int NUMA_MPOL_INTERLEAVE = 3;
+
+    inline void Mbind(void* p, size_t length, int mode, uint64_t nodes)
+    {
+        const unsigned long mask = nodes;
+        // maxnode на единицу больше числа бит маски: ядро отбрасывает последний бит
+        if (syscall(SYS_mbind, p, length, mode, &mask, sizeof(mask) * 8 + 1, 0) != 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "mbind");
+        }
+    }
+}  // namespace detail
+
+// Аллокатор, размещающий буферы на узлах NUMA согласно NumaPlacement и маске узлов nodes (бит i - узел i).
+// Буферы от страницы и больше отображаются через mmap и размещаются через mbind, меньшие выделяются
+// через operator new. Размещение входит в состояние аллокатора и переходит вместе с буфером
+// при копировании, перемещении и обмене векторов.
+// Если размещение невозможно (например, в маске нет существующих узлов), allocate выбрасывает std::system_error
+template <typename T>
+class NumaAllocator
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    // Экземпляры с разным размещением не взаимозаменяемы: буфер, выделенный по одной политике,
+    // не должен незаметно перейти к контейнеру с другой
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = NumaAllocator<U>;
+    };
+
+    explicit NumaAllocator(NumaPlacement placement = NUMA_LOCAL, uint64_t nodes = 0) noexcept
+        : placement_(placement), nodes_(nodes)
+    {
+    }
+
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) noexcept : placement_(other.Placement()), nodes_(other.Nodes())
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        // Длина отображения, округлённая до страницы, не должна переполнять size_t
+        if (n > (SIZE_MAX - detail::PageSize() + 1) / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        if (!IsMapped(n))
+        {
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+
+        const size_t length = MappedLength(n);
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        try
+        {
+            Place(static_cast<char*>(p), length);
+        }
+        catch (...)
+        {
+            munmap(p, length);
+            throw;
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        if (!IsMapped(n))
+        {
+            operator delete(p);
+            return;
+        }
+        munmap(p, MappedLength(n));
+    }
+
+    size_t usable_size(T* /*p*/, size_t n) const noexcept
+    {
+        return IsMapped(n) ? MappedLength(n) / sizeof(T) : n;
+    }
+
+    NumaPlacement Placement() const noexcept
+    {
+        return placement_;
+    }
+
+    uint64_t Nodes() const noexcept
+    {
+        return nodes_;
+    }
+
+    // Аллокаторы равны, если размещают буферы одинаково
+    template <typename U>
+    bool operator==(const NumaAllocator<U>& other) const noexcept
+    {
+        return placement_ == other.Placement() && nodes_ == other.Nodes();
+    }
+
+    template <typename U>
+    bool operator!=(const NumaAllocator<U>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    // Отображаются буферы от страницы и больше, длина отображения округляется до страницы
+    static bool IsMapped(size_t n) noexcept
+    {
+        return n * sizeof(T) >= detail::PageSize();
+    }
+
+    static size_t MappedLength(size_t n) noexcept
+    {
+        return detail::RoundUp(n * sizeof(T), detail::PageSize());
+    }
+
+    void Place(char* p, size_t length) const
+    {
+        switch (placement_)
+        {
+        case NUMA_LOCAL:
+            break;
+        case NUMA_INTERLEAVE:
+            detail::Mbind(p, length, detail::NUMA_MPOL_INTERLEAVE, nodes_);
+            break;
+        case NUMA_BIND:
+            detail::Mbind(p, length, detail::NUMA_MPOL_BIND, nodes_);
+            break;
+        case NUMA_PARTITIONED:
+        {
+            // Границы частей округляются до страниц
+            const size_t page_count = length / detail::PageSize();
+            const size_t node_count = static_cast<size_t>(__builtin_popcountll(nodes_));
+            size_t part = 0;
+            for (int node = 0; node < 64; ++node)
+            {
+                if ((nodes_ >> node & 1) == 0)
+                {
+                    continue;
+                }
+                const size_t first = page_count * part / node_count;
+                const size_t last = page_count * (part + 1) / node_count;
+                if (first < last)
+                {
+                    detail::Mbind(p + first * detail::PageSize(), (last - first) * detail::PageSize(),
+                                  detail::NUMA_MPOL_BIND, uint64_t{ 1 } << node);
+                }
+                ++part;
+            }
+            break;
+        }
+        }
+    }
+
+    NumaPlacement placement_;
+    uint64_t nodes_;
+};
+
+// Возвращает узел NUMA каждой страницы диапазона [p, p + bytes).
+// Для страниц, к которым ещё не было обращений, возвращается отрицательный код ошибки (-ENOENT)
+inline Vector<int> NumaPageNodes(const void* p, size_t bytes)
+{
+    const size_t page_size = detail::PageSize();
+    const uintptr_t first = reinterpret_cast<uintptr_t>(p) / page_size * page_size;
+    const uintptr_t last = reinterpret_cast<uintptr_t>(p) + bytes;
+    Vector<void*> pages;
+    pages.Reserve((last - first + page_size - 1) / page_size);
+    for (uintptr_t page = first; page < last; page += page_size)
+    {
+        pages.PushBack(reinterpret_cast<void*>(page));
+    }
+
+    Vector<int> nodes(pages.Size());
+    if (pages.Size() != 0
+        && syscall(SYS_move_pages, 0, pages.Size(), pages.begin(), nullptr, nodes.begin(), 0) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "move_pages");
+    }
+    return nodes;
+}
+
+// Возвращает узел NUMA, на котором целиком расположен диапазон [p, p + bytes),
+// или -1, если страницы диапазона лежат на разных узлах или ещё не выделены
+inline int NumaNodeOfRange(const void* p, size_t bytes)
+{
+    const Vector<int> nodes = NumaPageNodes(p, bytes);
+    if (nodes.Size() == 0 || nodes[0] < 0)
+    {
+        return -1;
+    }
+    for (int node : nodes)
+    {
+        if (node != nodes[0])
+        {
+            return -1;
+        }
+    }
+    return nodes[0];
+}
@@ -0,0 +1,246 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Пул рабочих потоков для ParallelExecution (требует -pthread).
+// Создаётся при первом обращении, по одному потоку на аппаратное ядро, кроме вызывающего.
+// Пул намеренно не разрушается: векторы со статическим временем жизни могут использовать его
+// в своих деструкторах во время завершения программы
+class ThreadPool
+{
+public:
+    static ThreadPool& Instance()
+    {
+        static ThreadPool* pool = new ThreadPool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        return *pool;
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+    void Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        has_tasks_.notify_one();
+    }
+
+private:
+    explicit ThreadPool(size_t size)
+    {
+        // Если поток создать не удалось, пул работает с теми потоками, что уже запущены
+        try
+        {
+            for (; size_ < size; ++size_)
+            {
+                std::thread([this] { Work(); }).detach();
+            }
+        }
+        catch (const std::system_error&)
+        {
+        }
+    }
+
+    void Work()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                has_tasks_.wait(lock, [this] { return !tasks_.empty(); });
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable has_tasks_;
+    std::deque<std::function<void()>> tasks_;
+    size_t size_ = 0;
+};
+
+// Параллельное выполнение массовых операций Vector в ThreadPool.
+// Диапазоны короче Threshold элементов обрабатываются последовательно.
+// Части диапазона разбирают и вызывающий поток, и потоки пула, поэтому вложенные параллельные
+// операции (например, копирование Vector<Vector<T, ...>, ...>) не ждут свободных потоков.
+// Если пул занят или не смог принять задачу, все части выполняет вызывающий поток.
+// Если не удалось подготовить параллельное выполнение (создать пул или состояние операции),
+// диапазон обрабатывается последовательно: ForEachChunk выбрасывает только исключения op.
+// Vector<Obj, std::allocator<Obj>, DoublingGrowth, ParallelExecution<>> table(size);
+template <size_t Threshold = size_t{ 1 } << 16>
+struct ParallelExecution
+{
+    template <typename Op, typename Rollback>
+    static void ForEachChunk(size_t count, Op&& op, Rollback&& rollback)
+    {
+        // Подготовка выделяет память и может выбросить исключение. Это происходит до начала работы,
+        // поэтому при неудаче диапазон обрабатывается последовательно: операции без исключений
+        // (например, разрушение элементов в деструкторе Vector) не становятся выбрасывающими
+        ThreadPool* pool = nullptr;
+        std::shared_ptr<Job> job;
+        if (count >= Threshold)
+        {
+            try
+            {
+                pool = &ThreadPool::Instance();
+                if (pool->Size() != 0)
+                {
+                    job = std::make_shared<Job>(count, std::min((pool->Size() + 1) * CHUNKS_PER_THREAD, count));
+                }
+            }
+            catch (...)
+            {
+                job = nullptr;
+            }
+        }
+        if (job == nullptr)
+        {
+            op(size_t{ 0 }, count);
+            return;
+        }
+
+        const size_t chunk_count = job->chunk_count;
+        Runner<Op> runner{ op, *job };
+
+        for (size_t i = 0; i < std::min(pool->Size(), chunk_count - 1); ++i)
+        {
+            try
+            {
+                // Задача может начаться уже после возврата из ForEachChunk, поэтому runner
+                // используется, только если поток пула присоединился до завершения операции
+                pool->Submit([job, &runner] {
+                    if (job->ClaimHelper())
+                    {
+                        runner.Run();
+                        job->ReleaseHelper();
+                    }
+                });
+            }
+            catch (...)
+            {
+                break;
+            }
+        }
+
+        runner.Run();
+        job->Wait();
+
+        if (job->error)
+        {
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+            {
+                if (job->done[chunk])
+                {
+                    rollback(job->ChunkBegin(chunk), job->ChunkBegin(chunk + 1));
+                }
+            }
+            std::rethrow_exception(job->error);
+        }
+    }
+
+private:
+    static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    // Общее состояние одной операции
+    struct Job
+    {
+        Job(size_t count, size_t chunk_count)
+            : count(count), chunk_count(chunk_count), done(std::make_unique<bool[]>(chunk_count))
+        {
+        }
+
+        size_t ChunkBegin(size_t chunk) const noexcept
+        {
+            return count / chunk_count * chunk + std::min(chunk, count % chunk_count);
+        }
+
+        // Поток пула присоединяется к операции, только если она ещё не завершена
+        bool ClaimHelper()
+        {
+            std::lock_guard lock(mutex);
+            if (finished)
+            {
+                return false;
+            }
+            ++helpers;
+            return true;
+        }
+
+        void ReleaseHelper()
+        {
+            std::lock_guard lock(mutex);
+            if (--helpers == 0)
+            {
+                all_helpers_left.notify_one();
+            }
+        }
+
+        // Ждёт, пока потоки пула не закончат свои части
+        void Wait()
+        {
+            std::unique_lock lock(mutex);
+            finished = true;
+            all_helpers_left.wait(lock, [this] { return helpers == 0; });
+        }
+
+        const size_t count;
+        const size_t chunk_count;
+        std::atomic<size_t> next_chunk{ 0 };
+        std::atomic<bool> failed{ false };
+        std::unique_ptr<bool[]> done;
+        std::exception_ptr error;
+
+        std::mutex mutex;
+        std::condition_variable all_helpers_left;
+        size_t helpers = 0;
+        bool finished = false;
+    };
+
+    template <typename Op>
+    struct Runner
+    {
+        // Разбирает и выполняет части, пока они не кончатся или одна из них не выбросит исключение
+        void Run() noexcept
+        {
+            for (size_t chunk; !job.failed.load(std::memory_order_relaxed)
+                               && (chunk = job.next_chunk.fetch_add(1, std::memory_order_relaxed)) < job.chunk_count;)
+            {
+                try
+                {
+                    op(job.ChunkBegin(chunk), job.ChunkBegin(chunk + 1));
+                    job.done[chunk] = true;
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(job.mutex);
+                    if (!job.error)
+                    {
+                        job.error = std::current_exception();
+                    }
+                    job.failed = true;
+                }
+            }
+        }
+
+        Op& op;
+        Job& job;
+    };
+};
@@ -0,0 +1,486 @@
+#pragma once
+#include "vector.h"
+#include "segments.h"
+
+// Вектор, который никогда не перемещает элементы при росте.
+// Элементы хранятся в сегментах SegmentLayout, размеры которых удваиваются: сегмент k вмещает
+// FirstSegmentSize * 2^k элементов. Когда вектор заполнен, выделяется следующий сегмент, а имеющиеся
+// элементы остаются на месте, поэтому добавление в конец выполняется за O(1) в худшем случае,
+// а ссылки, указатели и итераторы на элементы не становятся недействительными при росте.
+// Индекс переводится в номер сегмента и смещение за O(1) поиском старшего бита.
+// Интерфейс повторяет Vector; Insert и Erase сдвигают последующие элементы, как и у Vector.
+template <typename T, typename Alloc = std::allocator<T>, size_t FirstSegmentSize = 16>
+class SegmentedVector
+{
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using Layout = SegmentLayout<FirstSegmentSize>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>, "Alloc::value_type must be T");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "Fancy pointers are not supported");
+
+    // Итератор произвольного доступа: хранит вектор и индекс элемента,
+    // поэтому остаётся действительным при росте вектора
+    template <typename Value>
+    class Iterator
+    {
+        using Container = std::conditional_t<std::is_const_v<Value>, const SegmentedVector, SegmentedVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        Iterator() = default;
+
+        Iterator(Container* vector, size_t index) noexcept : vector_(vector), index_(index) {}
+
+        // Преобразование iterator в const_iterator
+        template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Value>>>
+        Iterator(const Iterator<Other>& other) noexcept : vector_(other.vector_), index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return (*vector_)[index_];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return &(*vector_)[index_];
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return (*vector_)[index_ + n];
+        }
+
+        Iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        Iterator& operator--() noexcept
+        {
+            --index_;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept
+        {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+
+        Iterator& operator+=(difference_type n) noexcept
+        {
+            index_ += n;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type n) noexcept
+        {
+            index_ -= n;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept
+        {
+            return lhs.index_ >= rhs.index_;
+        }
+
+        size_t Index() const noexcept
+        {
+            return index_;
+        }
+
+    private:
+        template <typename>
+        friend class Iterator;
+
+        Container* vector_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+    using allocator_type = Alloc;
+
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const Alloc& alloc) noexcept : alloc_(alloc) {}
+
+    // Алгоритмическая сложность: O(размер вектора).
+    explicit SegmentedVector(size_t size, const Alloc& alloc = Alloc()) : SegmentedVector(alloc)
+    {
+        Resize(size);
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+        : SegmentedVector(other, AllocTraits::select_on_container_copy_construction(other.alloc_))
+    {
+    }
+
+    // Делегирующий конструктор: если копирование элемента выбросит исключение,
+    // деструктор разрушит уже созданные элементы
+    SegmentedVector(const SegmentedVector& other, const Alloc& alloc) : SegmentedVector(alloc)
+    {
+        Reserve(other.size_);
+        for (const T& value : other)
+        {
+            EmplaceBack(value);
+        }
+    }
+
+    // Сегменты забираются целиком, элементы не перемещаются.
+    // Алгоритмическая сложность: O(число сегментов).
+    SegmentedVector(SegmentedVector&& other) noexcept : alloc_(std::move(other.alloc_))
+    {
+        TakeSegments(other);
+    }
+
+    ~SegmentedVector()
+    {
+        Release();
+    }
+
+    // Копия строится отдельно и обменивается с текущим содержимым (строгая гарантия безопасности исключений)
+    SegmentedVector& operator=(const SegmentedVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            SegmentedVector copy(rhs, AllocTraits::propagate_on_container_copy_assignment::value ? rhs.alloc_ : alloc_);
+            SwapSegments(copy);
+            std::swap(alloc_, copy.alloc_);
+        }
+        return *this;
+    }
+
+    // Если аллокатор не распространяется при перемещении и аллокаторы не равны,
+    // элементы перемещаются поштучно
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                                               || AllocTraits::is_always_equal::value)
+    {
+        if (this == &rhs)
+        {
+            return *this;
+        }
+
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value
+                      && !AllocTraits::is_always_equal::value)
+        {
+            if (alloc_ != rhs.alloc_)
+            {
+                Clear();
+                Reserve(rhs.size_);
+                for (T& value : rhs)
+                {
+                    EmplaceBack(std::move(value));
+                }
+                return *this;
+            }
+        }
+
+        Release();
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+        {
+            alloc_ = std::move(rhs.alloc_);
+        }
+        TakeSegments(rhs);
+        return *this;
+    }
+
+    // Если аллокатор не распространяется при обмене, аллокаторы векторов обязаны быть равны
+    void Swap(SegmentedVector& other) noexcept
+    {
+        if constexpr (AllocTraits::propagate_on_container_swap::value)
+        {
+            std::swap(alloc_, other.alloc_);
+        }
+        else
+        {
+            assert(alloc_ == other.alloc_);
+        }
+        SwapSegments(other);
+    }
+
+    // Выделяет сегменты, пока вместимость не станет не меньше new_capacity. Элементы не перемещаются
+    void Reserve(size_t new_capacity)
+    {
+        while (Capacity() < new_capacity)
+        {
+            AllocateSegment();
+        }
+    }
+
+    // Освобождает сегменты, в которых нет элементов
+    void ShrinkToFit() noexcept
+    {
+        const size_t needed = Layout::SegmentCountFor(size_);
+        while (segment_count_ > needed)
+        {
+            --segment_count_;
+            AllocTraits::deallocate(alloc_, segments_[segment_count_], Layout::SegmentSize(segment_count_));
+            segments_[segment_count_] = nullptr;
+        }
+    }
+
+    // Если конструктор элемента выбросит исключение, размер вектора не изменится
+    void Resize(size_t new_size)
+    {
+        if (new_size < size_)
+        {
+            while (size_ > new_size)
+            {
+                PopBack();
+            }
+            return;
+        }
+
+        Reserve(new_size);
+        const size_t old_size = size_;
+        try
+        {
+            while (size_ < new_size)
+            {
+                EmplaceBack();
+            }
+        }
+        catch (...)
+        {
+            Resize(old_size);
+            throw;
+        }
+    }
+
+    void Clear() noexcept
+    {
+        while (size_ > 0)
+        {
+            PopBack();
+        }
+    }
+
+    void PushBack(const T& value)
+    {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value)
+    {
+        EmplaceBack(std::move(value));
+    }
+
+    // Добавляет элемент в конец вектора. Если вектор заполнен, выделяется новый сегмент,
+    // имеющиеся элементы не перемещаются, поэтому аргументы могут ссылаться на элементы вектора.
+    // Алгоритмическая сложность: O(1) в худшем случае.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        if (size_ == Capacity())
+        {
+            AllocateSegment();
+        }
+        const SegmentPosition position = Layout::Locate(size_);
+        T* element = new (segments_[position.segment] + position.offset) T(std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    void PopBack() noexcept
+    {
+        if (size_ > 0)
+        {
+            std::destroy_at(&(*this)[size_ - 1]);
+            --size_;
+        }
+    }
+
+    // Вставляет элемент в позицию pos, сдвигая последующие элементы.
+    // Алгоритмическая сложность: O(число элементов после pos).
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args)
+    {
+        const size_t index = pos.Index();
+        assert(index <= size_);
+        EmplaceBack(std::forward<Args>(args)...);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    iterator Insert(const_iterator pos, const T& value)
+    {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value)
+    {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Удаляет элемент в позиции pos, сдвигая последующие элементы.
+    // Алгоритмическая сложность: O(число элементов после pos).
+    iterator Erase(const_iterator pos)
+    {
+        const size_t index = pos.Index();
+        assert(index < size_);
+        for (size_t i = index + 1; i < size_; ++i)
+        {
+            (*this)[i - 1] = detail::MoveOrCopy((*this)[i]);
+        }
+        PopBack();
+        return begin() + index;
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept
+    {
+        return iterator(this, size_);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator(this, size_);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+    // Суммарная вместимость выделенных сегментов
+    size_t Capacity() const noexcept
+    {
+        return Layout::SegmentBegin(segment_count_);
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        const SegmentPosition position = Layout::Locate(index);
+        return segments_[position.segment][position.offset];
+    }
+
+    Alloc GetAllocator() const noexcept
+    {
+        return alloc_;
+    }
+
+private:
+    void AllocateSegment()
+    {
+        if (segment_count_ == Layout::SEGMENT_COUNT)
+        {
+            throw std::length_error("SegmentedVector is too large");
+        }
+        segments_[segment_count_] = AllocTraits::allocate(alloc_, Layout::SegmentSize(segment_count_));
+        ++segment_count_;
+    }
+
+    void Release() noexcept
+    {
+        Clear();
+        ShrinkToFit();
+    }
+
+    void TakeSegments(SegmentedVector& other) noexcept
+    {
+        std::copy_n(other.segments_, other.segment_count_, segments_);
+        std::fill_n(other.segments_, other.segment_count_, nullptr);
+        segment_count_ = std::exchange(other.segment_count_, 0);
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    void SwapSegments(SegmentedVector& other) noexcept
+    {
+        std::swap_ranges(segments_, segments_ + std::max(segment_count_, other.segment_count_), other.segments_);
+        std::swap(segment_count_, other.segment_count_);
+        std::swap(size_, other.size_);
+    }
+
+    Alloc alloc_;
+    T* segments_[Layout::SEGMENT_COUNT] = {};
+    size_t segment_count_ = 0;
+    size_t size_ = 0;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+
+namespace detail
+{
+    constexpr size_t Log2(size_t value) noexcept
+    {
+        return std::numeric_limits<size_t>::digits - 1 - static_cast<size_t>(__builtin_clzl(value));
+    }
+}  // namespace detail
+
+// Положение элемента в сегментированном хранилище
+struct SegmentPosition
+{
+    size_t segment;
+    size_t offset;
+};
+
+// Разбиение индексов на сегменты, размер которых растёт степенями двойки:
+// сегмент k содержит FirstSegmentSize * 2^k элементов и начинается с индекса FirstSegmentSize * (2^k - 1).
+// Сегменты не перемещаются при росте, поэтому ссылки на элементы остаются действительными,
+// а номер сегмента вычисляется по индексу за O(1) без обращений к памяти
+template <size_t FirstSegmentSize>
+struct SegmentLayout
+{
+    static_assert(FirstSegmentSize > 0 && (FirstSegmentSize & (FirstSegmentSize - 1)) == 0,
+                  "FirstSegmentSize must be a power of two");
+
+    static constexpr size_t FIRST_SEGMENT_SIZE = FirstSegmentSize;
+    // Наибольшее число сегментов: их суммарный размер покрывает весь диапазон size_t
+    static constexpr size_t SEGMENT_COUNT = std::numeric_limits<size_t>::digits - detail::Log2(FirstSegmentSize);
+
+    static constexpr size_t SegmentSize(size_t segment) noexcept
+    {
+        return FirstSegmentSize << segment;
+    }
+
+    static constexpr size_t SegmentBegin(size_t segment) noexcept
+    {
+        return (FirstSegmentSize << segment) - FirstSegmentSize;
+    }
+
+    static constexpr SegmentPosition Locate(size_t index) noexcept
+    {
+        const size_t biased = index + FirstSegmentSize;
+        const size_t segment = detail::Log2(biased) - detail::Log2(FirstSegmentSize);
+        return { segment, biased - (FirstSegmentSize << segment) };
+    }
+
+    // Число сегментов, необходимое для хранения size элементов
+    static constexpr size_t SegmentCountFor(size_t size) noexcept
+    {
+        return size == 0 ? 0 : Locate(size - 1).segment + 1;
+    }
+};
@@ -0,0 +1,636 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <limits>
+
+// Набор векторных инструкций, которыми пользуются алгоритмы Simd*
+enum SimdLevel
+{
+    // Поэлементный цикл без векторов
+    SIMD_SCALAR,
+    // 16-байтные векторы базового набора инструкций платформы (SSE2 на x86-64)
+    SIMD_BASELINE,
+    // 32-байтные векторы AVX2
+    SIMD_AVX2,
+    // 64-байтные векторы AVX-512 (AVX512F и AVX512BW)
+    SIMD_AVX512,
+};
+
+// Сравнение элемента со значением в SimdEraseIf
+enum SimdCompare
+{
+    SIMD_LESS,
+    SIMD_LESS_EQUAL,
+    SIMD_GREATER,
+    SIMD_GREATER_EQUAL,
+    SIMD_EQUAL,
+    SIMD_NOT_EQUAL,
+};
+
+// Ядра встраиваются в функции, скомпилированные под конкретный набор инструкций,
+// поэтому соглашение о передаче широких векторов между функциями их не касается
+#define SIMD_ALWAYS_INLINE inline __attribute__((always_inline))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace detail
+{
+    inline SimdLevel DetectSimdLevel() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        // __builtin_cpu_supports учитывает и поддержку регистров AVX операционной системой
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        {
+            return SIMD_AVX512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return SIMD_AVX2;
+        }
+#endif
+        return SIMD_BASELINE;
+    }
+
+    inline std::atomic<SimdLevel>& SimdLevelLimit() noexcept
+    {
+        static std::atomic<SimdLevel> limit{ SIMD_AVX512 };
+        return limit;
+    }
+}  // namespace detail
+
+// Наибольший набор инструкций, поддерживаемый процессором (определяется при первом вызове),
+// с учётом ограничения LimitSimdLevel
+inline SimdLevel GetSimdLevel() noexcept
+{
+    static const SimdLevel detected = detail::DetectSimdLevel();
+    return std::min(detected, detail::SimdLevelLimit().load(std::memory_order_relaxed));
+}
+
+// Запрещает алгоритмам Simd* наборы инструкций шире level (для сравнения производительности и отладки)
+inline void LimitSimdLevel(SimdLevel level) noexcept
+{
+    detail::SimdLevelLimit().store(level, std::memory_order_relaxed);
+}
+
+namespace detail
+{
+    template <typename T>
+    struct SimdIdentity
+    {
+        using type = T;
+    };
+
+    // Значение не участвует в выводе типа: SimdFill(floats, 1) не конфликтует с T = float
+    template <typename T>
+    using SimdValue = typename SimdIdentity<T>::type;
+
+    // Операции ядер
+    struct SimdFillOp {};
+    struct SimdFindOp {};
+    struct SimdCountOp {};
+    struct SimdMinMaxOp {};
+    struct SimdSumOp {};
+    struct SimdDotOp {};
+    struct SimdTransformOp {};
+    struct SimdEraseOp {};
+
+    // Преобразования SimdTransformOp на месте: x * a + b, x + b и x * a
+    struct SimdMultiplyAdd
+    {
+        template <typename U, typename T>
+        SIMD_ALWAYS_INLINE static void Apply(U& x, T a, T b) noexcept
+        {
+            x = x * a + b;
+        }
+    };
+
+    struct SimdAdd
+    {
+        template <typename U, typename T>
+        SIMD_ALWAYS_INLINE static void Apply(U& x, T, T b) noexcept
+        {
+            x = x + b;
+        }
+    };
+
+    struct SimdMultiply
+    {
+        template <typename U, typename T>
+        SIMD_ALWAYS_INLINE static void Apply(U& x, T a, T) noexcept
+        {
+            x = x * a;
+        }
+    };
+
+    // Сравнения SimdEraseOp. Для векторов результат - маска: -1 в совпавших дорожках, 0 в остальных
+    template <SimdCompare Compare>
+    struct SimdComparator
+    {
+        template <typename U, typename Result>
+        SIMD_ALWAYS_INLINE static void Apply(const U& x, const U& y, Result& result) noexcept
+        {
+            if constexpr (Compare == SIMD_LESS)
+            {
+                result = x < y;
+            }
+            else if constexpr (Compare == SIMD_LESS_EQUAL)
+            {
+                result = x <= y;
+            }
+            else if constexpr (Compare == SIMD_GREATER)
+            {
+                result = x > y;
+            }
+            else if constexpr (Compare == SIMD_GREATER_EQUAL)
+            {
+                result = x >= y;
+            }
+            else if constexpr (Compare == SIMD_EQUAL)
+            {
+                result = x == y;
+            }
+            else
+            {
+                result = x != y;
+            }
+        }
+    };
+
+    // Типы арифметики ядер. Целые числа складываются и умножаются в беззнаковых типах:
+    // переполнение в них определено и даёт тот же результат по модулю, что и в T
+    template <typename T, bool = std::is_integral_v<T>>
+    struct SimdArithmetic
+    {
+        // Тип дорожки вектора
+        using Lane = T;
+        // Тип поэлементных вычислений (не меньше unsigned int, чтобы продвижение не вело к знаковому переполнению)
+        using Scalar = T;
+    };
+
+    template <typename T>
+    struct SimdArithmetic<T, true>
+    {
+        using Lane = std::make_unsigned_t<T>;
+        using Scalar = decltype(Lane{} + 0u);
+    };
+
+    // Ядра алгоритмов над векторами GCC шириной Bytes байт (Bytes == sizeof(T) - поэлементный цикл).
+    // Векторы передаются только по ссылке: вне функций с атрибутом target передача широких векторов
+    // по значению меняет соглашение о вызовах.
+    // Загрузки и сохранения невыровненные: буфер RawMemory выровнен только по alignof(T),
+    // а на современных процессорах невыровненная загрузка выровненных данных не медленнее выровненной.
+    // Остаток, не кратный ширине вектора, обрабатывается поэлементно
+    template <typename T, size_t Bytes>
+    struct SimdKernel
+    {
+        typedef T Vec __attribute__((vector_size(Bytes)));
+        // Вектор в памяти, выровненный только по alignof(T). Векторный тип GCC может ссылаться
+        // на элементы своего типа, поэтому обращение к массиву T через него не нарушает правила псевдонимов.
+        // Вычисления ведутся в Vec: при выводе шаблонных параметров пониженное выравнивание теряется
+        typedef T UnalignedVec __attribute__((vector_size(Bytes), aligned(alignof(T))));
+        // Результат сравнения векторов: знаковые целые той же ширины, что T
+        using MaskLane = std::conditional_t<sizeof(T) == 1, int8_t,
+                         std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>;
+        typedef MaskLane Mask __attribute__((vector_size(Bytes)));
+        using Lane = typename SimdArithmetic<T>::Lane;
+        using Scalar = typename SimdArithmetic<T>::Scalar;
+        typedef Lane LaneVec __attribute__((vector_size(Bytes)));
+
+        static constexpr size_t LANES = Bytes / sizeof(T);
+
+        SIMD_ALWAYS_INLINE static const UnalignedVec& At(const T* p) noexcept
+        {
+            return *reinterpret_cast<const UnalignedVec*>(p);
+        }
+
+        SIMD_ALWAYS_INLINE static UnalignedVec& At(T* p) noexcept
+        {
+            return *reinterpret_cast<UnalignedVec*>(p);
+        }
+
+        SIMD_ALWAYS_INLINE static bool AnyLane(const Mask& m) noexcept
+        {
+            MaskLane any = 0;
+            for (size_t lane = 0; lane < LANES; ++lane)
+            {
+                any |= m[lane];
+            }
+            return any != 0;
+        }
+
+        SIMD_ALWAYS_INLINE static bool AllLanes(const Mask& m) noexcept
+        {
+            MaskLane all = -1;
+            for (size_t lane = 0; lane < LANES; ++lane)
+            {
+                all &= m[lane];
+            }
+            return all != 0;
+        }
+
+        SIMD_ALWAYS_INLINE static void Run(SimdFillOp, T* p, size_t n, T value) noexcept
+        {
+            const Vec v = Vec{} + value;
+            size_t i = 0;
+            for (; i + LANES <= n; i += LANES)
+            {
+                At(p + i) = v;
+            }
+            for (; i < n; ++i)
+            {
+                p[i] = value;
+            }
+        }
+
+        SIMD_ALWAYS_INLINE static size_t Run(SimdFindOp, const T* p, size_t n, T value) noexcept
+        {
+            const Vec v = Vec{} + value;
+            size_t i = 0;
+            for (; i + LANES <= n; i += LANES)
+            {
+                const Mask m = At(p + i) == v;
+                if (AnyLane(m))
+                {
+                    for (size_t lane = 0;; ++lane)
+                    {
+                        if (m[lane])
+                        {
+                            return i + lane;
+                        }
+                    }
+                }
+            }
+            for (; i < n; ++i)
+            {
+                if (p[i] == value)
+                {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        // Совпадения накапливаются в дорожках маски (каждое совпадение вычитает -1) и сбрасываются
+        // в общий счётчик до того, как дорожка может переполниться
+        SIMD_ALWAYS_INLINE static size_t Run(SimdCountOp, const T* p, size_t n, T value) noexcept
+        {
+            constexpr size_t MAX_BLOCK = static_cast<size_t>(std::numeric_limits<MaskLane>::max());
+            const Vec v = Vec{} + value;
+            size_t count = 0;
+            size_t i = 0;
+            while (n - i >= LANES)
+            {
+                const size_t block_end = i + std::min((n - i) / LANES, MAX_BLOCK) * LANES;
+                Mask lanes{};
+                for (; i < block_end; i += LANES)
+                {
+                    lanes -= At(p + i) == v;
+                }
+                for (size_t lane = 0; lane < LANES; ++lane)
+                {
+                    count += static_cast<size_t>(lanes[lane]);
+                }
+            }
+            for (; i < n; ++i)
+            {
+                count += p[i] == value;
+            }
+            return count;
+        }
+
+        SIMD_ALWAYS_INLINE static std::pair<T, T> Run(SimdMinMaxOp, const T* p, size_t n) noexcept
+        {
+            T min = p[0];
+            T max = p[0];
+            size_t i = 0;
+            if (n >= LANES)
+            {
+                Vec lo = At(p);
+                Vec hi = lo;
+                for (i = LANES; i + LANES <= n; i += LANES)
+                {
+                    const Vec x = At(p + i);
+                    lo = x < lo ? x : lo;
+                    hi = x > hi ? x : hi;
+                }
+                for (size_t lane = 0; lane < LANES; ++lane)
+                {
+                    min = lo[lane] < min ? lo[lane] : min;
+                    max = hi[lane] > max ? hi[lane] : max;
+                }
+            }
+            for (; i < n; ++i)
+            {
+                min = p[i] < min ? p[i] : min;
+                max = p[i] > max ? p[i] : max;
+            }
+            return { min, max };
+        }
+
+        SIMD_ALWAYS_INLINE static T Run(SimdSumOp, const T* p, size_t n) noexcept
+        {
+            LaneVec acc{};
+            size_t i = 0;
+            for (; i + LANES <= n; i += LANES)
+            {
+                acc += (LaneVec)At(p + i);
+            }
+            Scalar sum{};
+            for (size_t lane = 0; lane < LANES; ++lane)
+            {
+                sum += acc[lane];
+            }
+            for (; i < n; ++i)
+            {
+                sum += static_cast<Scalar>(p[i]);
+            }
+            return static_cast<T>(sum);
+        }
+
+        SIMD_ALWAYS_INLINE static T Run(SimdDotOp, const T* a, const T* b, size_t n) noexcept
+        {
+            LaneVec acc{};
+            size_t i = 0;
+            for (; i + LANES <= n; i += LANES)
+            {
+                acc += (LaneVec)At(a + i) * (LaneVec)At(b + i);
+            }
+            Scalar sum{};
+            for (size_t lane = 0; lane < LANES; ++lane)
+            {
+                sum += acc[lane];
+            }
+            for (; i < n; ++i)
+            {
+                sum += static_cast<Scalar>(a[i]) * static_cast<Scalar>(b[i]);
+            }
+            return static_cast<T>(sum);
+        }
+
+        template <typename Transform>
+        SIMD_ALWAYS_INLINE static void Run(SimdTransformOp, Transform, T* p, size_t n, T a, T b) noexcept
+        {
+            size_t i = 0;
+            for (; i + LANES <= n; i += LANES)
+            {
+                LaneVec x = (LaneVec)At(p + i);
+                Transform::Apply(x, static_cast<Lane>(a), static_cast<Lane>(b));
+                At(p + i) = (Vec)x;
+            }
+            for (; i < n; ++i)
+            {
+                Scalar x = static_cast<Scalar>(p[i]);
+                Transform::Apply(x, static_cast<Scalar>(a), static_cast<Scalar>(b));
+                p[i] = static_cast<T>(x);
+            }
+        }
+
+        // Сдвигает к началу элементы, для которых сравнение ложно, и возвращает их число.
+        // Векторы без удаляемых элементов переносятся целиком, векторы из одних удаляемых пропускаются
+        template <typename Comparator>
+        SIMD_ALWAYS_INLINE static size_t Run(SimdEraseOp, Comparator, T* p, size_t n, T value) noexcept
+        {
+            const Vec v = Vec{} + value;
+            size_t kept = 0;
+            size_t i = 0;
+            for (; i + LANES <= n; i += LANES)
+            {
+                const Vec x = At(p + i);
+                Mask erase;
+                Comparator::Apply(x, v, erase);
+                if (!AnyLane(erase))
+                {
+                    if (kept != i)
+                    {
+                        // Запись может задеть только уже загруженные элементы [kept, i + LANES)
+                        At(p + kept) = x;
+                    }
+                    kept += LANES;
+                }
+                else if (!AllLanes(erase))
+                {
+                    for (size_t lane = 0; lane < LANES; ++lane)
+                    {
+                        if (!erase[lane])
+                        {
+                            p[kept++] = x[lane];
+                        }
+                    }
+                }
+            }
+            for (; i < n; ++i)
+            {
+                bool erase;
+                Comparator::Apply(p[i], value, erase);
+                if (!erase)
+                {
+                    p[kept++] = p[i];
+                }
+            }
+            return kept;
+        }
+    };
+
+    template <typename T, size_t Bytes, typename Op, typename... Args>
+    auto SimdRunBaseline(Op op, Args... args) noexcept
+    {
+        return SimdKernel<T, Bytes>::Run(op, args...);
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    template <typename T, typename Op, typename... Args>
+    __attribute__((target("avx2"))) auto SimdRunAvx2(Op op, Args... args) noexcept
+    {
+        return SimdKernel<T, 32>::Run(op, args...);
+    }
+
+    template <typename T, typename Op, typename... Args>
+    __attribute__((target("avx512f,avx512bw"))) auto SimdRunAvx512(Op op, Args... args) noexcept
+    {
+        return SimdKernel<T, 64>::Run(op, args...);
+    }
+#endif
+
+    // Выполняет операцию ядром самого широкого набора инструкций, доступного по GetSimdLevel()
+    template <typename T, typename Op, typename... Args>
+    auto SimdDispatch(Op op, Args... args) noexcept
+    {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double>,
+                      "Only integral and float/double elements are supported");
+
+        switch (GetSimdLevel())
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            case SIMD_AVX512:
+                return SimdRunAvx512<T>(op, args...);
+            case SIMD_AVX2:
+                return SimdRunAvx2<T>(op, args...);
+#endif
+            case SIMD_SCALAR:
+                return SimdRunBaseline<T, sizeof(T)>(op, args...);
+            default:
+                return SimdRunBaseline<T, 16>(op, args...);
+        }
+    }
+}  // namespace detail
+
+// Векторизованные алгоритмы над непрерывными массивами целых чисел, float и double.
+// Каждый вызов выбирает ядро AVX-512, AVX2, базовое 16-байтное или поэлементное по GetSimdLevel().
+// Суммы и скалярное произведение складывают элементы в другом порядке, чем последовательный цикл,
+// поэтому для float и double результат может отличаться от него ошибкой округления.
+// Целые числа складываются и умножаются в типе T, как в std::accumulate с начальным значением T{}.
+// Если в данных есть NaN, результат SimdMinMax не определён
+
+template <typename T>
+void SimdFill(T* data, size_t size, detail::SimdValue<T> value) noexcept
+{
+    detail::SimdDispatch<T>(detail::SimdFillOp{}, data, size, value);
+}
+
+// Индекс первого элемента, равного value, или size, если такого нет
+template <typename T>
+size_t SimdFind(const T* data, size_t size, detail::SimdValue<T> value) noexcept
+{
+    return detail::SimdDispatch<T>(detail::SimdFindOp{}, data, size, value);
+}
+
+template <typename T>
+size_t SimdCount(const T* data, size_t size, detail::SimdValue<T> value) noexcept
+{
+    return detail::SimdDispatch<T>(detail::SimdCountOp{}, data, size, value);
+}
+
+// Наименьший и наибольший элементы непустого массива
+template <typename T>
+std::pair<T, T> SimdMinMax(const T* data, size_t size) noexcept
+{
+    assert(size > 0);
+    return detail::SimdDispatch<T>(detail::SimdMinMaxOp{}, data, size);
+}
+
+template <typename T>
+T SimdSum(const T* data, size_t size) noexcept
+{
+    return detail::SimdDispatch<T>(detail::SimdSumOp{}, data, size);
+}
+
+template <typename T>
+T SimdDot(const T* a, const T* b, size_t size) noexcept
+{
+    return detail::SimdDispatch<T>(detail::SimdDotOp{}, a, b, size);
+}
+
+// data[i] = data[i] * a + b
+template <typename T>
+void SimdMultiplyAdd(T* data, size_t size, detail::SimdValue<T> a, detail::SimdValue<T> b) noexcept
+{
+    detail::SimdDispatch<T>(detail::SimdTransformOp{}, detail::SimdMultiplyAdd{}, data, size, a, b);
+}
+
+template <typename T>
+void SimdAdd(T* data, size_t size, detail::SimdValue<T> b) noexcept
+{
+    detail::SimdDispatch<T>(detail::SimdTransformOp{}, detail::SimdAdd{}, data, size, T{}, b);
+}
+
+template <typename T>
+void SimdMultiply(T* data, size_t size, detail::SimdValue<T> a) noexcept
+{
+    detail::SimdDispatch<T>(detail::SimdTransformOp{}, detail::SimdMultiply{}, data, size, a, T{});
+}
+
+// Удаляет элементы, для которых верно сравнение "элемент compare value", сохраняя порядок остальных.
+// Возвращает новый размер массива; элементы за ним остаются в неопределённом состоянии
+template <typename T>
+size_t SimdEraseIf(T* data, size_t size, SimdCompare compare, detail::SimdValue<T> value) noexcept
+{
+    switch (compare)
+    {
+        case SIMD_LESS:
+            return detail::SimdDispatch<T>(detail::SimdEraseOp{}, detail::SimdComparator<SIMD_LESS>{}, data, size, value);
+        case SIMD_LESS_EQUAL:
+            return detail::SimdDispatch<T>(detail::SimdEraseOp{}, detail::SimdComparator<SIMD_LESS_EQUAL>{}, data, size, value);
+        case SIMD_GREATER:
+            return detail::SimdDispatch<T>(detail::SimdEraseOp{}, detail::SimdComparator<SIMD_GREATER>{}, data, size, value);
+        case SIMD_GREATER_EQUAL:
+            return detail::SimdDispatch<T>(detail::SimdEraseOp{}, detail::SimdComparator<SIMD_GREATER_EQUAL>{}, data, size, value);
+        case SIMD_EQUAL:
+            return detail::SimdDispatch<T>(detail::SimdEraseOp{}, detail::SimdComparator<SIMD_EQUAL>{}, data, size, value);
+        default:
+            return detail::SimdDispatch<T>(detail::SimdEraseOp{}, detail::SimdComparator<SIMD_NOT_EQUAL>{}, data, size, value);
+    }
+}
+
+// Те же алгоритмы над Vector
+
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+void SimdFill(Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector, detail::SimdValue<T> value) noexcept
+{
+    SimdFill(vector.begin(), vector.Size(), value);
+}
+
+// Индекс первого элемента, равного value, или Size(), если такого нет
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+size_t SimdFind(const Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector, detail::SimdValue<T> value) noexcept
+{
+    return SimdFind(vector.begin(), vector.Size(), value);
+}
+
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+size_t SimdCount(const Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector, detail::SimdValue<T> value) noexcept
+{
+    return SimdCount(vector.begin(), vector.Size(), value);
+}
+
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+std::pair<T, T> SimdMinMax(const Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector) noexcept
+{
+    return SimdMinMax(vector.begin(), vector.Size());
+}
+
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+T SimdSum(const Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector) noexcept
+{
+    return SimdSum(vector.begin(), vector.Size());
+}
+
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+T SimdDot(const Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& a, const Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& b) noexcept
+{
+    assert(a.Size() == b.Size());
+    return SimdDot(a.begin(), b.begin(), a.Size());
+}
+
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+void SimdMultiplyAdd(Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector, detail::SimdValue<T> a, detail::SimdValue<T> b) noexcept
+{
+    SimdMultiplyAdd(vector.begin(), vector.Size(), a, b);
+}
+
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+void SimdAdd(Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector, detail::SimdValue<T> b) noexcept
+{
+    SimdAdd(vector.begin(), vector.Size(), b);
+}
+
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+void SimdMultiply(Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector, detail::SimdValue<T> a) noexcept
+{
+    SimdMultiply(vector.begin(), vector.Size(), a);
+}
+
+// Удаляет элементы, для которых верно сравнение "элемент compare value", и возвращает их число.
+// Алгоритмическая сложность: O(размер вектора).
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+size_t SimdEraseIf(Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector, SimdCompare compare, detail::SimdValue<T> value)
+{
+    const size_t kept = SimdEraseIf(vector.begin(), vector.Size(), compare, value);
+    const size_t removed = vector.Size() - kept;
+    vector.Erase(vector.begin() + kept, vector.end());
+    return removed;
+}
+
+#pragma GCC diagnostic pop
+#undef SIMD_ALWAYS_INLINE
@@ -0,0 +1,491 @@
+#pragma once
+#include "vector.h"
+
+// Динамический массив с оптимизацией малого буфера (small buffer optimization).
+// Первые N элементов хранятся непосредственно внутри объекта, без обращения к аллокатору.
+// Когда элементы перестают помещаться во встроенный буфер, они переносятся в RawMemory,
+// после чего SmallVector ведёт себя так же, как Vector.
+// Интерфейс и гарантии безопасности исключений совпадают с Vector.
+template <typename T, size_t N, typename Alloc = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class SmallVector
+{
+    static_assert(N > 0, "Inline capacity must be positive");
+
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    // Перемещающее присваивание не выделяет память, если буфер rhs всегда можно забрать вместе с аллокатором,
+    // и тогда не выбрасывает исключений, если их не выбрасывает перемещение элементов встроенного буфера
+    static constexpr bool NOTHROW_MOVE_ASSIGN =
+        (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+        && std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using allocator_type = Alloc;
+
+    // Конструктор по умолчанию. Создаёт пустой вектор, использующий встроенный буфер.
+    // Алгоритмическая сложность: O(1).
+    SmallVector() = default;
+
+    explicit SmallVector(const Alloc& alloc) noexcept : heap_(alloc) {}
+
+    // Конструктор, который создаёт вектор заданного размера с элементами, проинициализированными по умолчанию.
+    // Память выделяется только если size больше N.
+    // Алгоритмическая сложность: O(размер вектора).
+    explicit SmallVector(size_t size, const Alloc& alloc = Alloc()) : heap_(size > N ? size : 0, alloc)
+    {
+        std::uninitialized_value_construct_n(begin(), size);
+        size_ = size;
+    }
+
+    // Копирующий конструктор. Если элементы помещаются во встроенный буфер, память не выделяется.
+    // Алгоритмическая сложность: O(размер исходного вектора).
+    SmallVector(const SmallVector& other)
+        : heap_(other.size_ > N ? other.size_ : 0,
+                AllocTraits::select_on_container_copy_construction(other.heap_.GetAllocator()))
+    {
+        std::uninitialized_copy_n(other.begin(), other.size_, begin());
+        size_ = other.size_;
+    }
+
+    // Конструктор перемещения. Буфер в куче забирается целиком,
+    // элементы встроенного буфера переносятся поштучно.
+    // Алгоритмическая сложность: O(1) для буфера в куче, O(N) для встроенного буфера.
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T> || IsTriviallyRelocatableV<T>)
+        : heap_(other.heap_.GetAllocator())
+    {
+        if (other.IsInline())
+        {
+            Transfer(other.begin(), other.size_, begin());
+        }
+        else
+        {
+            heap_.Swap(other.heap_);
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    ~SmallVector()
+    {
+        std::destroy_n(begin(), size_);
+    }
+
+    SmallVector& operator=(const SmallVector& rhs)
+    {
+        if (this == &rhs)
+        {
+            return *this;
+        }
+
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+        {
+            if (heap_.GetAllocator() != rhs.heap_.GetAllocator())
+            {
+                if (IsInline())
+                {
+                    // Прежний аллокатор не владеет памятью, и его можно просто заменить
+                    heap_.GetAllocator() = rhs.heap_.GetAllocator();
+                }
+                else
+                {
+                    // Текущий буфер в куче освобождает только прежний аллокатор, поэтому копия строится
+                    // в буфере аллокатора rhs или во встроенном буфере, свободном, пока элементы лежат в куче.
+                    // Если копирование выбросит исключение, вектор не изменится
+                    RawMemory<T, Alloc> new_heap(rhs.size_ > N ? rhs.size_ : 0, rhs.heap_.GetAllocator());
+                    T* new_begin = new_heap.GetAddress() != nullptr ? new_heap.GetAddress() : InlineData();
+                    std::uninitialized_copy_n(rhs.begin(), rhs.size_, new_begin);
+                    std::destroy_n(begin(), size_);
+                    heap_.Swap(new_heap);
+                    size_ = rhs.size_;
+                    return *this;
+                }
+            }
+        }
+
+        AssignN(rhs.begin(), rhs.size_);
+        return *this;
+    }
+
+    // Буфер rhs в куче забирается целиком, если его может освободить аллокатор этого вектора.
+    // Иначе элементы перемещаются поштучно. После перемещения rhs пуст.
+    SmallVector& operator=(SmallVector&& rhs) noexcept(NOTHROW_MOVE_ASSIGN)
+    {
+        if (this == &rhs)
+        {
+            return *this;
+        }
+
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+        {
+            if (heap_.GetAllocator() != rhs.heap_.GetAllocator())
+            {
+                Clear();
+                heap_ = RawMemory<T, Alloc>(rhs.heap_.GetAllocator());
+            }
+        }
+
+        if (!rhs.IsInline() && heap_.GetAllocator() == rhs.heap_.GetAllocator())
+        {
+            Clear();
+            heap_ = std::move(rhs.heap_);
+        }
+        else
+        {
+            AssignN(std::make_move_iterator(rhs.begin()), rhs.size_);
+            std::destroy_n(rhs.begin(), rhs.size_);
+        }
+
+        size_ = rhs.size_;
+        rhs.size_ = 0;
+        return *this;
+    }
+
+    // Обменивает содержимое двух векторов.
+    // Буферы в куче обмениваются за O(1), встроенные буферы требуют поэлементного перемещения.
+    void Swap(SmallVector& other) noexcept(NOTHROW_MOVE_ASSIGN)
+    {
+        if (!IsInline() && !other.IsInline())
+        {
+            if constexpr (!AllocTraits::propagate_on_container_swap::value)
+            {
+                assert(heap_.GetAllocator() == other.heap_.GetAllocator());
+            }
+            heap_.Swap(other.heap_);
+            std::swap(size_, other.size_);
+            return;
+        }
+
+        SmallVector temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    allocator_type GetAllocator() const
+    {
+        return heap_.GetAllocator();
+    }
+
+    // Резервирует место под new_capacity элементов.
+    // Если новая вместимость не превышает текущую, метод не делает ничего.
+    // Алгоритмическая сложность: O(размер вектора).
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity <= Capacity())
+        {
+            return;
+        }
+
+        if constexpr (IsTriviallyRelocatableV<T> && AllocatorHasReallocateV<Alloc>)
+        {
+            if (!IsInline())
+            {
+                heap_.Reallocate(new_capacity);
+                return;
+            }
+        }
+
+        RawMemory<T, Alloc> new_data(new_capacity, heap_.GetAllocator());
+        Transfer(begin(), size_, new_data.GetAddress());
+        heap_.Swap(new_data);
+    }
+
+    void Resize(size_t new_size)
+    {
+        if (new_size > size_)
+        {
+            Reserve(new_size);
+            std::uninitialized_value_construct_n(begin() + size_, new_size - size_);
+        }
+        else if (new_size < size_)
+        {
+            std::destroy_n(begin() + new_size, size_ - new_size);
+        }
+
+        size_ = new_size;
+    }
+
+    void PushBack(const T& value)
+    {
+        Emplace(end(), value);
+    }
+
+    void PushBack(T&& value)
+    {
+        Emplace(end(), std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        return *(Emplace(end(), std::forward<Args>(args)...));
+    }
+
+    void PopBack() /* noexcept */
+    {
+        if (size_ > 0)
+        {
+            std::destroy_at(end() - 1);
+            --size_;
+        }
+    }
+
+    iterator begin() noexcept
+    {
+        return IsInline() ? InlineData() : heap_.GetAddress();
+    }
+
+    iterator end() noexcept
+    {
+        return begin() + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_cast<SmallVector&>(*this).begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return begin() + size_;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args)
+    {
+        assert(pos >= begin() && pos <= end());
+
+        size_t index = pos - begin();
+
+        if (size_ == Capacity())
+        {
+            return EmplaceReallocate(index, std::forward<Args>(args)...);
+        }
+        else
+        {
+            return EmplaceWithoutReallocate(index, std::forward<Args>(args)...);
+        }
+    }
+
+    iterator Erase(const_iterator pos)
+    {
+        assert(pos >= begin() && pos < end());
+
+        size_t index = pos - begin();
+
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            std::destroy_at(begin() + index);
+            detail::RelocateOverlapping(begin() + index + 1, size_ - index - 1, begin() + index);
+        }
+        else
+        {
+            if constexpr (detail::PreferMoveV<T>)
+            {
+                std::move(begin() + index + 1, end(), begin() + index);
+            }
+            else
+            {
+                std::copy(begin() + index + 1, end(), begin() + index);
+            }
+
+            std::destroy_at(end() - 1);
+        }
+
+        --size_;
+        return begin() + index;
+    }
+
+    iterator Insert(const_iterator pos, const T& value)
+    {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value)
+    {
+        return Emplace(pos, std::move(value));
+    }
+
+    size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return IsInline() ? N : heap_.Capacity();
+    }
+
+    // Возвращает true, пока элементы хранятся во встроенном буфере
+    bool IsInline() const noexcept
+    {
+        return heap_.GetAddress() == nullptr;
+    }
+
+    const T& operator[](size_t index) const noexcept
+    {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        return begin()[index];
+    }
+
+private:
+    // Буфер в куче. Пока он пуст, элементы хранятся во встроенном буфере
+    RawMemory<T, Alloc> heap_;
+    size_t size_ = 0;
+    alignas(T) unsigned char inline_[sizeof(T) * N];
+
+    T* InlineData() noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(inline_));
+    }
+
+    void Clear() noexcept
+    {
+        std::destroy_n(begin(), size_);
+        size_ = 0;
+    }
+
+    // Переносит count элементов из src в неинициализированную память dst.
+    // После переноса память src считается сырой
+    static void Transfer(T* src, size_t count, T* dst)
+    {
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::Relocate(src, count, dst);
+        }
+        else
+        {
+            detail::UninitializedCopyOrMove(src, count, dst);
+            std::destroy_n(src, count);
+        }
+    }
+
+    template <typename... Args>
+    iterator EmplaceReallocate(size_t index, Args&&... args)
+    {
+        const size_t new_capacity = std::max(GrowthPolicy::NextCapacity(Capacity(), sizeof(T)), size_ + 1);
+        RawMemory<T, Alloc> new_data(new_capacity, heap_.GetAllocator());
+        T* new_begin = new_data.GetAddress();
+
+        // Новый элемент создаётся первым: аргументы могут ссылаться на элементы текущего буфера
+        new (new_begin + index) T(std::forward<Args>(args)...);
+
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::Relocate(begin(), index, new_begin);
+            detail::Relocate(begin() + index, size_ - index, new_begin + index + 1);
+        }
+        else
+        {
+            try
+            {
+                detail::UninitializedCopyOrMove(begin(), index, new_begin);
+            }
+            catch (...)
+            {
+                std::destroy_at(new_begin + index);
+                throw;
+            }
+            try
+            {
+                detail::UninitializedCopyOrMove(begin() + index, size_ - index, new_begin + index + 1);
+            }
+            catch (...)
+            {
+                std::destroy_n(new_begin, index + 1);
+                throw;
+            }
+            std::destroy_n(begin(), size_);
+        }
+
+        heap_.Swap(new_data);
+        ++size_;
+        return begin() + index;
+    }
+
+    template <typename... Args>
+    iterator EmplaceWithoutReallocate(size_t index, Args&&... args)
+    {
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            if (index < size_)
+            {
+                alignas(T) unsigned char storage[sizeof(T)];
+                T* temp = new (storage) T(std::forward<Args>(args)...);
+                detail::RelocateOverlapping(begin() + index, size_ - index, begin() + index + 1);
+                detail::Relocate(temp, 1, begin() + index);
+                ++size_;
+                return begin() + index;
+            }
+        }
+
+        if (index < size_)
+        {
+            T temp(std::forward<Args>(args)...);
+            std::uninitialized_move_n(end() - 1, 1, end());
+            std::move_backward(begin() + index, end() - 1, end());
+
+            *(begin() + index) = std::move(temp);
+        }
+        else
+        {
+            new (end()) T(std::forward<Args>(args)...);
+        }
+        ++size_;
+        return begin() + index;
+    }
+
+    // Заменяет содержимое вектора n элементами, начиная с first
+    template <typename InputIt>
+    void AssignN(InputIt first, size_t n)
+    {
+        if (Capacity() < n)
+        {
+            RawMemory<T, Alloc> new_data(n, heap_.GetAllocator());
+            std::uninitialized_copy_n(first, n, new_data.GetAddress());
+            std::destroy_n(begin(), size_);
+            heap_.Swap(new_data);
+        }
+        else
+        {
+            const size_t common = std::min(size_, n);
+            for (size_t i = 0; i < common; ++i, ++first)
+            {
+                begin()[i] = *first;
+            }
+
+            if (size_ < n)
+            {
+                std::uninitialized_copy_n(first, n - size_, begin() + size_);
+            }
+            else if (size_ > n)
+            {
+                std::destroy_n(begin() + n, size_ - n);
+            }
+        }
+
+        size_ = n;
+    }
+};
+
+// Адрес данных вычисляется при каждом обращении, а не хранится в объекте,
+// поэтому SmallVector можно переносить побайтово вместе с элементами встроенного буфера
+template <typename T, size_t N, typename Alloc, typename GrowthPolicy>
+struct IsTriviallyRelocatable<SmallVector<T, N, Alloc, GrowthPolicy>>
+    : std::bool_constant<IsTriviallyRelocatableV<T> && IsTriviallyRelocatableV<Alloc>> {};
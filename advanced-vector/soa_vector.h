@@ -0,0 +1,403 @@
+#pragma once
+#include "vector.h"
+
+#include <tuple>
+
+// Непрерывный участок столбца SoaVector
+template <typename T>
+class ColumnSpan
+{
+public:
+    ColumnSpan(T* data, size_t size) noexcept : data_(data), size_(size) {}
+
+    T* begin() const noexcept
+    {
+        return data_;
+    }
+
+    T* end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    T* Data() const noexcept
+    {
+        return data_;
+    }
+
+    size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+    T& operator[](size_t index) const noexcept
+    {
+        assert(index < size_);
+        return data_[index];
+    }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+// Контейнер в виде структуры массивов (structure of arrays).
+// Каждое поле строки хранится в отдельном столбце RawMemory<Field>, размер и вместимость у столбцов общие.
+// Проход по одному полю читает только его столбец, поэтому не тратит пропускную способность памяти
+// на остальные поля и векторизуется компилятором.
+// Строка доступна через operator[] в виде кортежа ссылок на поля: auto [x, y, id] = points[i];
+// Рост вместимости и гарантии безопасности исключений такие же, как у Vector.
+template <typename... Fields>
+class SoaVector
+{
+    static_assert(sizeof...(Fields) > 0, "At least one field is required");
+
+    using Columns = std::tuple<RawMemory<Fields>...>;
+    using Indices = std::index_sequence_for<Fields...>;
+
+    template <size_t I>
+    using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    // Перенос столбца может выбросить исключение: такие столбцы копируются до остальных,
+    // чтобы при ошибке исходные элементы остались нетронутыми
+    template <typename T>
+    static constexpr bool TransferMayThrowV = !IsTriviallyRelocatableV<T> && !std::is_nothrow_move_constructible_v<T>;
+
+public:
+    using Row = std::tuple<Fields&...>;
+    using ConstRow = std::tuple<const Fields&...>;
+
+    SoaVector() = default;
+
+    // Создаёт size строк, поля которых проинициализированы значением по умолчанию.
+    // Алгоритмическая сложность: O(размер вектора).
+    explicit SoaVector(size_t size) : columns_(RawMemory<Fields>(size)...), capacity_(size)
+    {
+        ValueConstruct(columns_, 0, size, Indices{});
+        size_ = size;
+    }
+
+    SoaVector(const SoaVector& other) : columns_(RawMemory<Fields>(other.size_)...), capacity_(other.size_)
+    {
+        CopyConstruct(other.columns_, other.size_, columns_, Indices{});
+        size_ = other.size_;
+    }
+
+    SoaVector(SoaVector&& other) noexcept
+        : columns_(std::move(other.columns_))
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0))
+    {
+    }
+
+    ~SoaVector()
+    {
+        Destroy(columns_, 0, size_, Indices{});
+    }
+
+    // Копия строится отдельно и обменивается с текущим содержимым (строгая гарантия безопасности исключений)
+    SoaVector& operator=(const SoaVector& rhs)
+    {
+        if (this != &rhs)
+        {
+            SoaVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    SoaVector& operator=(SoaVector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            SoaVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    void Swap(SoaVector& other) noexcept
+    {
+        SwapColumns(other.columns_, Indices{});
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity <= capacity_)
+        {
+            return;
+        }
+        Columns new_columns{ RawMemory<Fields>(new_capacity)... };
+        Transfer(columns_, size_, new_columns, Indices{});
+        SwapColumns(new_columns, Indices{});
+        capacity_ = new_capacity;
+    }
+
+    // Если конструктор поля выбросит исключение, вектор останется прежним
+    void Resize(size_t new_size)
+    {
+        if (new_size < size_)
+        {
+            Destroy(columns_, new_size, size_, Indices{});
+        }
+        else
+        {
+            Reserve(new_size);
+            ValueConstruct(columns_, size_, new_size, Indices{});
+        }
+        size_ = new_size;
+    }
+
+    void Clear() noexcept
+    {
+        Destroy(columns_, 0, size_, Indices{});
+        size_ = 0;
+    }
+
+    void PushBack(const Fields&... values)
+    {
+        EmplaceBack(values...);
+    }
+
+    // Добавляет строку, поле i которой создаётся из аргумента i.
+    // Аргументы могут ссылаться на элементы этого же вектора.
+    // Алгоритмическая сложность: амортизированная O(1).
+    template <typename... Args>
+    Row EmplaceBack(Args&&... args)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "One argument per field is required");
+
+        if (size_ == capacity_)
+        {
+            const size_t new_capacity = std::max(DoublingGrowth::NextCapacity(capacity_, RowSize()), size_ + 1);
+            Columns new_columns{ RawMemory<Fields>(new_capacity)... };
+            // Новая строка создаётся до переноса: аргументы могут ссылаться на переносимые элементы
+            ConstructRow(new_columns, size_, Indices{}, std::forward<Args>(args)...);
+            try
+            {
+                Transfer(columns_, size_, new_columns, Indices{});
+            }
+            catch (...)
+            {
+                Destroy(new_columns, size_, size_ + 1, Indices{});
+                throw;
+            }
+            SwapColumns(new_columns, Indices{});
+            capacity_ = new_capacity;
+        }
+        else
+        {
+            ConstructRow(columns_, size_, Indices{}, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return (*this)[size_ - 1];
+    }
+
+    void PopBack() noexcept
+    {
+        if (size_ > 0)
+        {
+            Destroy(columns_, size_ - 1, size_, Indices{});
+            --size_;
+        }
+    }
+
+    // Удаляет строку index, сдвигая последующие строки.
+    // Алгоритмическая сложность: O(число строк после index).
+    void Erase(size_t index)
+    {
+        Erase(index, index + 1);
+    }
+
+    // Удаляет строки [first, last), сдвигая последующие строки.
+    // Алгоритмическая сложность: O(число строк после first).
+    void Erase(size_t first, size_t last)
+    {
+        assert(first <= last && last <= size_);
+        if (first == last)
+        {
+            return;
+        }
+        ShiftLeft(first, last, Indices{});
+        Destroy(columns_, size_ - (last - first), size_, Indices{});
+        size_ -= last - first;
+    }
+
+    // Столбец поля I
+    template <size_t I>
+    ColumnSpan<Field<I>> Column() noexcept
+    {
+        return { std::get<I>(columns_).GetAddress(), size_ };
+    }
+
+    template <size_t I>
+    ColumnSpan<const Field<I>> Column() const noexcept
+    {
+        return { std::get<I>(columns_).GetAddress(), size_ };
+    }
+
+    Row operator[](size_t index) noexcept
+    {
+        assert(index < size_);
+        return GetRow<Row>(*this, index, Indices{});
+    }
+
+    ConstRow operator[](size_t index) const noexcept
+    {
+        assert(index < size_);
+        return GetRow<ConstRow>(*this, index, Indices{});
+    }
+
+    size_t Size() const noexcept
+    {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+private:
+    static constexpr size_t RowSize() noexcept
+    {
+        return (sizeof(Fields) + ...);
+    }
+
+    template <typename Result, typename Self, size_t... I>
+    static Result GetRow(Self& self, size_t index, std::index_sequence<I...>) noexcept
+    {
+        return Result(std::get<I>(self.columns_)[index]...);
+    }
+
+    template <size_t... I>
+    void SwapColumns(Columns& other, std::index_sequence<I...>) noexcept
+    {
+        (std::get<I>(columns_).Swap(std::get<I>(other)), ...);
+    }
+
+    template <size_t... I>
+    static void Destroy(Columns& columns, size_t first, size_t last, std::index_sequence<I...>) noexcept
+    {
+        (std::destroy_n(std::get<I>(columns) + first, last - first), ...);
+    }
+
+    // Разрушает строки [first, last) в столбцах с номерами меньше count (столбцах, заполненных до ошибки)
+    template <size_t... I>
+    static void DestroyPrefix(Columns& columns, size_t count, size_t first, size_t last, std::index_sequence<I...>) noexcept
+    {
+        ((I < count ? void(std::destroy_n(std::get<I>(columns) + first, last - first)) : void()), ...);
+    }
+
+    template <size_t... I, typename... Args>
+    static void ConstructRow(Columns& columns, size_t index, std::index_sequence<I...>, Args&&... args)
+    {
+        size_t built = 0;
+        try
+        {
+            ((new (std::get<I>(columns) + index) Fields(std::forward<Args>(args)), ++built), ...);
+        }
+        catch (...)
+        {
+            DestroyPrefix(columns, built, index, index + 1, Indices{});
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    static void ValueConstruct(Columns& columns, size_t first, size_t last, std::index_sequence<I...>)
+    {
+        size_t built = 0;
+        try
+        {
+            ((std::uninitialized_value_construct_n(std::get<I>(columns) + first, last - first), ++built), ...);
+        }
+        catch (...)
+        {
+            DestroyPrefix(columns, built, first, last, Indices{});
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    static void CopyConstruct(const Columns& from, size_t count, Columns& to, std::index_sequence<I...>)
+    {
+        size_t built = 0;
+        try
+        {
+            ((std::uninitialized_copy_n(std::get<I>(from).GetAddress(), count, std::get<I>(to).GetAddress()), ++built), ...);
+        }
+        catch (...)
+        {
+            DestroyPrefix(to, built, 0, count, Indices{});
+            throw;
+        }
+    }
+
+    // Переносит count строк в новые столбцы to. Сначала копируются столбцы, перенос которых
+    // может выбросить исключение; если это произошло, исходные столбцы не изменяются.
+    // Остальные столбцы переносятся побайтово или перемещением без исключений.
+    template <size_t... I>
+    static void Transfer(Columns& from, size_t count, Columns& to, std::index_sequence<I...>)
+    {
+        size_t copied = 0;
+        try
+        {
+            ((TransferMayThrowV<Fields> ? detail::UninitializedCopyOrMove(std::get<I>(from).GetAddress(), count,
+                                                                           std::get<I>(to).GetAddress())
+                                        : void(),
+              ++copied),
+             ...);
+        }
+        catch (...)
+        {
+            ((I < copied && TransferMayThrowV<Fields> ? void(std::destroy_n(std::get<I>(to) + 0, count)) : void()), ...);
+            throw;
+        }
+
+        (TransferNoThrow(std::get<I>(from), count, std::get<I>(to)), ...);
+    }
+
+    template <typename T>
+    static void TransferNoThrow(RawMemory<T>& from, size_t count, RawMemory<T>& to) noexcept
+    {
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::Relocate(from.GetAddress(), count, to.GetAddress());
+        }
+        else
+        {
+            if constexpr (!TransferMayThrowV<T>)
+            {
+                std::uninitialized_move_n(from.GetAddress(), count, to.GetAddress());
+            }
+            std::destroy_n(from.GetAddress(), count);
+        }
+    }
+
+    template <size_t... I>
+    void ShiftLeft(size_t first, size_t last, std::index_sequence<I...>)
+    {
+        (ShiftColumnLeft(std::get<I>(columns_), first, last, size_), ...);
+    }
+
+    // Сдвигает элементы [last, size) столбца на место [first, ...), перемещая или копируя их согласно PreferMoveV
+    template <typename T>
+    static void ShiftColumnLeft(RawMemory<T>& column, size_t first, size_t last, size_t size)
+    {
+        if constexpr (detail::PreferMoveV<T>)
+        {
+            std::move(column + last, column + size, column + first);
+        }
+        else
+        {
+            std::copy(column + last, column + size, column + first);
+        }
+    }
+
+    Columns columns_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
@@ -1,25 +1,171 @@
 #pragma once
 #include <cassert>
+#include <cstdint>
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <new>
 #include <utility>
 #include <algorithm>
+#include <iterator>
 #include <memory>   // uninitialized_value_construct_n, uninitialized_copy_n, destroy_n, uninitialized_move_n
+#include <type_traits>
 
+#if defined(__GLIBC__)
+#include <malloc.h>  // malloc_usable_size
+#endif
+
+// Признак тривиальной перемещаемости (trivially relocatable): объект можно перенести в другую
+// область памяти побайтовым копированием, не вызывая конструктор перемещения и деструктор исходного объекта.
+// Автоматически выполняется для тривиально копируемых типов. Для остальных типов признак
+// включается явной специализацией, если тип не хранит указателей на самого себя.
+// Например, std::string в libstdc++ хранит указатель на собственный SSO-буфер и перемещаемым не является.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T, typename Deleter>
+struct IsTriviallyRelocatable<std::unique_ptr<T, Deleter>> : IsTriviallyRelocatable<Deleter> {};
+
+// std::allocator не имеет состояния, хотя и объявляет собственный копирующий конструктор
+template <typename T>
+struct IsTriviallyRelocatable<std::allocator<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+// Признак аллокатора, умеющего изменять размер ранее выделенного блока:
+// T* reallocate(T* p, size_t old_n, size_t new_n).
+// Содержимое блока переносится побайтово, поэтому реаллокация применяется только к тривиально перемещаемым типам.
+// При неудаче reallocate выбрасывает исключение, оставляя исходный блок нетронутым.
+template <typename Alloc, typename = void>
+struct AllocatorHasReallocate : std::false_type {};
+
+template <typename Alloc>
+struct AllocatorHasReallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+    std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename Alloc>
+inline constexpr bool AllocatorHasReallocateV = AllocatorHasReallocate<Alloc>::value;
+
+// Признак аллокатора, сообщающего фактический размер выделенного блока:
+// size_t usable_size(T* p, size_t n) возвращает количество элементов (не меньше n), которое помещается в блок.
+// RawMemory использует его, чтобы вместимость совпадала с размерным классом аллокатора.
+// В deallocate и reallocate такой аллокатор получает уже фактическое количество элементов.
+template <typename Alloc, typename = void>
+struct AllocatorHasUsableSize : std::false_type {};
+
+template <typename Alloc>
+struct AllocatorHasUsableSize<Alloc, std::void_t<decltype(std::declval<const Alloc&>().usable_size(
+    std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_t{}))>> : std::true_type {};
+
+template <typename Alloc>
+inline constexpr bool AllocatorHasUsableSizeV = AllocatorHasUsableSize<Alloc>::value;
+
+// Признак аллокатора, умеющего возвращать системе физическую память неиспользуемой части блока:
+// void discard(T* p, size_t n, size_t first) для блока p из n элементов освобождает страницы,
+// целиком занятые элементами [first, n). Сам блок остаётся выделенным.
+template <typename Alloc, typename = void>
+struct AllocatorHasDiscard : std::false_type {};
+
+template <typename Alloc>
+struct AllocatorHasDiscard<Alloc, std::void_t<decltype(std::declval<Alloc&>().discard(
+    std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename Alloc>
+inline constexpr bool AllocatorHasDiscardV = AllocatorHasDiscard<Alloc>::value;
+
+// Аллокатор поверх malloc/realloc/free.
+// Позволяет вектору тривиально перемещаемых элементов расти на месте: realloc расширяет блок,
+// если за ним есть свободная память, а крупные блоки glibc переотображает через mremap без копирования страниц.
 template <typename T>
+struct MallocAllocator
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not guarantee extended alignment");
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    MallocAllocator() noexcept = default;
+
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        if (n > SIZE_MAX / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        void* p = std::malloc(n * sizeof(T));
+        if (p == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept
+    {
+        std::free(p);
+    }
+
+    T* reallocate(T* p, size_t /*old_n*/, size_t new_n)
+    {
+        if (new_n > SIZE_MAX / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+        void* new_p = std::realloc(static_cast<void*>(p), new_n * sizeof(T));
+        if (new_p == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(new_p);
+    }
+
+#if defined(__GLIBC__)
+    size_t usable_size(T* p, size_t /*n*/) const noexcept
+    {
+        return malloc_usable_size(static_cast<void*>(p)) / sizeof(T);
+    }
+#endif
+
+    template <typename U>
+    bool operator==(const MallocAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const MallocAllocator<U>&) const noexcept
+    {
+        return false;
+    }
+};
+
+template <typename T, typename Alloc = std::allocator<T>>
 class RawMemory
 {
 public:
+    using allocator_type = Alloc;
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>, "Alloc::value_type must be T");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "Fancy pointers are not supported");
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity) : buffer_(Allocate(capacity)), capacity_(capacity) {}
+    explicit RawMemory(const Alloc& alloc) noexcept : alloc_(alloc) {}
+
+    explicit RawMemory(size_t capacity, const Alloc& alloc = Alloc()) : alloc_(alloc), buffer_(Allocate(capacity)), capacity_(UsableSize(buffer_, capacity)) {}
 
     RawMemory(const RawMemory&) = delete;
 
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
     // Перемещающий конструктор (RawMemory move constructor)
-    RawMemory(RawMemory&& other) noexcept : buffer_(other.buffer_), capacity_(other.capacity_)
+    // Аллокатор переезжает вместе с буфером: только он может этот буфер освободить
+    RawMemory(RawMemory&& other) noexcept : alloc_(std::move(other.alloc_)), buffer_(other.buffer_), capacity_(other.capacity_)
     {
         // Обнуляем ресурсы в other, чтобы деструктор other не освободил память
         other.buffer_ = nullptr;
@@ -31,7 +177,8 @@ public:
     {
         if (this != &rhs)
         {
-            Deallocate(buffer_);
+            Deallocate(buffer_, capacity_);
+            alloc_ = std::move(rhs.alloc_);
             buffer_ = rhs.buffer_;
             capacity_ = rhs.capacity_;
             rhs.buffer_ = nullptr;
@@ -42,7 +189,7 @@ public:
 
     ~RawMemory()
     {
-        Deallocate(buffer_);
+        Deallocate(buffer_, capacity_);
     }
 
     T* operator+(size_t offset) noexcept
@@ -68,8 +215,12 @@ public:
         return buffer_[index];
     }
 
+    // Обменивает буферы вместе с аллокаторами, которыми они были выделены.
+    // Решение о том, допустим ли обмен аллокаторов, принимает владелец (Vector)
     void Swap(RawMemory& other) noexcept
     {
+        using std::swap;
+        swap(alloc_, other.alloc_);
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
     }
@@ -89,51 +240,376 @@ public:
         return capacity_;
     }
 
+    // Изменяет вместимость буфера, сохраняя его содержимое побайтово.
+    // Доступно только для аллокаторов с методом reallocate. Если реаллокация не удалась,
+    // выбрасывается исключение, а буфер остаётся прежним.
+    void Reallocate(size_t new_capacity)
+    {
+        static_assert(AllocatorHasReallocateV<Alloc>, "Alloc does not support reallocate");
+
+        if (buffer_ == nullptr)
+        {
+            buffer_ = Allocate(new_capacity);
+        }
+        else if (new_capacity == 0)
+        {
+            Deallocate(buffer_, capacity_);
+            buffer_ = nullptr;
+        }
+        else
+        {
+            buffer_ = alloc_.reallocate(buffer_, capacity_, new_capacity);
+        }
+        capacity_ = UsableSize(buffer_, new_capacity);
+    }
+
+    // Сообщает аллокатору, что память элементов [first, Capacity()) не используется.
+    // Аллокатор с методом discard может вернуть её страницы системе, остальные аллокаторы игнорируют вызов
+    void Discard(size_t first) noexcept
+    {
+        if constexpr (AllocatorHasDiscardV<Alloc>)
+        {
+            if (buffer_ != nullptr && first < capacity_)
+            {
+                alloc_.discard(buffer_, capacity_, first);
+            }
+        }
+    }
+
+    const Alloc& GetAllocator() const noexcept
+    {
+        return alloc_;
+    }
+
+    Alloc& GetAllocator() noexcept
+    {
+        return alloc_;
+    }
+
 private:
     // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n)
+    T* Allocate(size_t n)
     {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+        return n != 0 ? AllocTraits::allocate(alloc_, n) : nullptr;
+    }
+
+    // Возвращает фактическую вместимость блока buf, выделенного под n элементов
+    size_t UsableSize(T* buf, size_t n) const noexcept
+    {
+        if constexpr (AllocatorHasUsableSizeV<Alloc>)
+        {
+            return buf != nullptr ? std::max(alloc_.usable_size(buf, n), n) : n;
+        }
+        else
+        {
+            return n;
+        }
     }
 
     // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept
+    void Deallocate(T* buf, size_t n) noexcept
     {
-        operator delete(buf);
+        if (buf != nullptr)
+        {
+            AllocTraits::deallocate(alloc_, buf, n);
+        }
     }
 
+    Alloc alloc_;
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
+// Вспомогательные алгоритмы над сырой памятью, общие для контейнеров на основе RawMemory
+namespace detail
+{
+    // Переносит count элементов из first в неинициализированную память result побайтовым копированием.
+    // После переноса память first считается сырой: деструкторы перенесённых объектов не вызываются
+    template <typename T>
+    void Relocate(T* first, size_t count, T* result) noexcept
+    {
+        if (count != 0)
+        {
+            std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), count * sizeof(T));
+        }
+    }
+
+    // То же, что Relocate, но исходный и целевой диапазоны могут перекрываться
+    template <typename T>
+    void RelocateOverlapping(T* first, size_t count, T* result) noexcept
+    {
+        if (count != 0)
+        {
+            std::memmove(static_cast<void*>(result), static_cast<const void*>(first), count * sizeof(T));
+        }
+    }
+
+    // Ограничение шаблонов, принимающих пару итераторов: отсекает, например, Vector<int>(5, 3)
+    template <typename It>
+    using RequireInputIterator = std::enable_if_t<
+        std::is_convertible_v<typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>;
+
+    template <typename It>
+    inline constexpr bool IsForwardIteratorV =
+        std::is_convertible_v<typename std::iterator_traits<It>::iterator_category, std::forward_iterator_tag>;
+
+    // Элементы перемещаются, если перемещение не выбрасывает исключений или тип некопируем,
+    // иначе копируются, чтобы при исключении исходные элементы остались нетронутыми
+    template <typename T>
+    inline constexpr bool PreferMoveV = std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+
+    template <typename T>
+    std::conditional_t<PreferMoveV<T>, T&&, const T&> MoveOrCopy(T& value) noexcept
+    {
+        return std::move(value);
+    }
+
+    // Перемещает или копирует элементы в неинициализированную память согласно PreferMoveV
+    template <typename InputIt, typename OutputIt>
+    void UninitializedCopyOrMove(InputIt first, size_t count, OutputIt result)
+    {
+        using T = typename std::iterator_traits<InputIt>::value_type;
+        if constexpr (PreferMoveV<T>)
+        {
+            std::uninitialized_move_n(first, count, result);
+        }
+        else
+        {
+            std::uninitialized_copy_n(first, count, result);
+        }
+    }
+
+    // Массовые операции над элементами, которые политика выполнения ExecutionPolicy может разбить на части.
+    // Если часть выбросила исключение, уже построенные части разрушаются, и вектор остаётся неизменным
+    template <typename ExecutionPolicy, typename T>
+    void UninitializedValueConstructN(T* first, size_t count)
+    {
+        ExecutionPolicy::ForEachChunk(
+            count, [first](size_t begin, size_t end) { std::uninitialized_value_construct_n(first + begin, end - begin); },
+            [first](size_t begin, size_t end) noexcept { std::destroy_n(first + begin, end - begin); });
+    }
+
+    template <typename ExecutionPolicy, typename InputIt, typename T>
+    void UninitializedCopyN(InputIt first, size_t count, T* result)
+    {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::random_access_iterator_tag>)
+        {
+            ExecutionPolicy::ForEachChunk(
+                count, [first, result](size_t begin, size_t end) { std::uninitialized_copy_n(first + begin, end - begin, result + begin); },
+                [result](size_t begin, size_t end) noexcept { std::destroy_n(result + begin, end - begin); });
+        }
+        else
+        {
+            std::uninitialized_copy_n(first, count, result);
+        }
+    }
+
+    template <typename ExecutionPolicy, typename T>
+    void DestroyN(T* first, size_t count) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            ExecutionPolicy::ForEachChunk(
+                count, [first](size_t begin, size_t end) noexcept { std::destroy_n(first + begin, end - begin); },
+                [](size_t, size_t) noexcept {});
+        }
+    }
+}  // namespace detail
+
+// Тег конструктора Vector, создающего элементы без инициализации значением:
+// Vector<char> buffer(size, DEFAULT_INIT);
+struct DefaultInitTag
+{
+    explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag DEFAULT_INIT{};
+
+// Политики роста вместимости Vector.
+// NextCapacity(capacity, element_size) вызывается, когда вектор заполнен, и возвращает новую вместимость.
+// Вектор дополнительно гарантирует, что вместимость не меньше требуемой.
+
+// Удвоение вместимости (по умолчанию)
+struct DoublingGrowth
+{
+    static size_t NextCapacity(size_t capacity, size_t /*element_size*/) noexcept
+    {
+        return capacity == 0 ? 1 : capacity * 2;
+    }
+};
+
+// Рост в 1.5 раза: освободившиеся блоки со временем можно переиспользовать под следующий буфер
+struct OneAndHalfGrowth
+{
+    static size_t NextCapacity(size_t capacity, size_t /*element_size*/) noexcept
+    {
+        return capacity < 2 ? capacity + 1 : capacity + capacity / 2;
+    }
+};
+
+// Рост в 1.625 раза, приближение золотого сечения
+struct GoldenRatioGrowth
+{
+    static size_t NextCapacity(size_t capacity, size_t /*element_size*/) noexcept
+    {
+        return capacity < 2 ? capacity + 1 : capacity + capacity / 2 + capacity / 8;
+    }
+};
+
+// Округляет вместимость базовой политики вверх так, чтобы буфер занимал целое число страниц
+template <typename Base = DoublingGrowth, size_t PageSize = 4096>
+struct PageRoundedGrowth
+{
+    static_assert((PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    static size_t NextCapacity(size_t capacity, size_t element_size) noexcept
+    {
+        const size_t base = Base::NextCapacity(capacity, element_size);
+        const size_t bytes = (base * element_size + PageSize - 1) & ~(PageSize - 1);
+        return std::max(base, bytes / element_size);
+    }
+};
+
+// Политика роста может также разрешать автоматическое уменьшение вместимости:
+// ShrinkCapacity(size, capacity, element_size) вызывается после удаления элементов
+// и возвращает новую вместимость (или текущую, если уменьшать её не нужно).
+template <typename Policy, typename = void>
+struct GrowthPolicyHasShrink : std::false_type {};
+
+template <typename Policy>
+struct GrowthPolicyHasShrink<Policy, std::void_t<decltype(Policy::ShrinkCapacity(size_t{}, size_t{}, size_t{}))>>
+    : std::true_type {};
+
+template <typename Policy>
+inline constexpr bool GrowthPolicyHasShrinkV = GrowthPolicyHasShrink<Policy>::value;
+
+// Добавляет к политике роста Base автоматическое уменьшение вместимости с гистерезисом.
+// Когда размер падает ниже доли Numerator / Denominator от вместимости, вместимость уменьшается
+// до той, что выбрала бы Base для текущего размера. После этого вектор заполнен заметно выше порога,
+// поэтому чередование вставок и удалений на границе не вызывает реаллокаций на каждой операции.
+// Порог должен быть меньше обратного коэффициента роста Base (для удвоения - меньше 1/2).
+// Вместимость не уменьшается ниже MinCapacity.
+template <typename Base = DoublingGrowth, size_t Numerator = 1, size_t Denominator = 4, size_t MinCapacity = 16>
+struct HysteresisShrink : Base
+{
+    static_assert(Numerator < Denominator, "Shrink threshold must be a fraction below 1");
+
+    static size_t ShrinkCapacity(size_t size, size_t capacity, size_t element_size) noexcept
+    {
+        if (capacity <= MinCapacity || size * Denominator >= capacity * Numerator)
+        {
+            return capacity;
+        }
+        return std::min(capacity, std::max(Base::NextCapacity(size, element_size), MinCapacity));
+    }
+};
+
+// Политика выполнения массовых операций Vector: создания элементов в Vector(size),
+// копирования в копирующем конструкторе и операторе присваивания и разрушения в деструкторе.
+// ForEachChunk(count, op, rollback) вызывает op(begin, end) для частей диапазона [0, count).
+// Каждый вызов op либо обрабатывает свою часть целиком, либо выбрасывает исключение, ничего не оставив.
+// При исключении для всех завершённых частей вызывается rollback(begin, end), после чего исключение
+// передаётся дальше. Если исключение невозможно, ForEachChunk также не должна выбрасывать исключений.
+
+// Последовательное выполнение в текущем потоке (по умолчанию)
+struct SequentialExecution
+{
+    template <typename Op, typename Rollback>
+    static void ForEachChunk(size_t count, Op&& op, Rollback&& /*rollback*/)
+    {
+        op(size_t{ 0 }, count);
+    }
+};
+
+// Политика сбора статистики Vector. Вектор сообщает о событиях статическим функциям политики:
+// OnAllocate(capacity_bytes) - получен буфер вместимостью capacity_bytes байт (новый или изменённый на месте);
+// OnRelocate(bytes) - при реаллокации в новый буфер перенесены прежние элементы общим размером bytes;
+// OnShift(bytes) - при вставке или удалении внутри буфера сдвинут хвост размером bytes.
+// Функции вызываются после успешного завершения операции и не должны выбрасывать исключений.
+
+// Статистика не собирается (по умолчанию): пустые функции встраиваются и не оставляют кода
+struct NoStats
+{
+    static void OnAllocate(size_t /*capacity_bytes*/) noexcept {}
+
+    static void OnRelocate(size_t /*bytes*/) noexcept {}
+
+    static void OnShift(size_t /*bytes*/) noexcept {}
+};
+
+template <typename T, typename Alloc = std::allocator<T>, typename GrowthPolicy = DoublingGrowth,
+          typename ExecutionPolicy = SequentialExecution, typename StatsPolicy = NoStats>
 class Vector
 {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
 public:
     using iterator = T*;
     using const_iterator = const T*;
+    using allocator_type = Alloc;
 
     // Конструктор по умолчанию. Инициализирует вектор нулевого размера и вместимости.
     // Не выбрасывает исключений.
     // Алгоритмическая сложность: O(1).
     Vector() = default;
 
+    // Конструктор пустого вектора, использующего заданный аллокатор.
+    // Алгоритмическая сложность: O(1).
+    explicit Vector(const Alloc& alloc) noexcept : data_(alloc) {}
+
     // Конструктор, который создаёт вектор заданного размера.
     // Вместимость созданного вектора равна его размеру,
     // а элементы проинициализированы значением по умолчанию для типа T.
     // Алгоритмическая сложность : O(размер вектора).
-    explicit Vector(size_t size) : data_(size), size_(size)
+    explicit Vector(size_t size, const Alloc& alloc = Alloc()) : data_(size, alloc), size_(size)
+    {
+        detail::UninitializedValueConstructN<ExecutionPolicy>(begin(), size);
+        CountAllocation(data_);
+    }
+
+    // Конструктор, который создаёт вектор заданного размера с элементами, инициализированными
+    // по умолчанию (default-initialization). Для тривиальных типов память не заполняется нулями.
+    // Алгоритмическая сложность: O(1) для тривиальных типов, иначе O(размер вектора).
+    Vector(size_t size, DefaultInitTag, const Alloc& alloc = Alloc()) : data_(size, alloc), size_(size)
     {
-        std::uninitialized_value_construct_n(begin(), size);
+        std::uninitialized_default_construct_n(begin(), size);
+        CountAllocation(data_);
+    }
+
+    // Конструктор из диапазона [first, last).
+    // Для однонаправленных итераторов память выделяется один раз, точно под размер диапазона.
+    // Алгоритмическая сложность: O(размер диапазона).
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    Vector(InputIt first, InputIt last, const Alloc& alloc = Alloc()) : data_(alloc)
+    {
+        try
+        {
+            Append(first, last);
+        }
+        catch (...)
+        {
+            // Деструктор не будет вызван для недостроенного объекта
+            std::destroy_n(begin(), size_);
+            throw;
+        }
     }
 
     // Копирующий конструктор. Создаёт копию элементов исходного вектора.
     // Имеет вместимость, равную размеру исходного вектора,
     // то есть выделяет память без запаса.
+    // Аллокатор копии выбирается через select_on_container_copy_construction.
     // Алгоритмическая сложность: O(размер исходного вектора).
-    Vector(const Vector& other) : data_(other.size_), size_(other.size_)
+    Vector(const Vector& other)
+        : Vector(other, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
     {
-        std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, begin());
+    }
+
+    // Копирующий конструктор с явно заданным аллокатором.
+    Vector(const Vector& other, const Alloc& alloc) : data_(other.size_, alloc), size_(other.size_)
+    {
+        detail::UninitializedCopyN<ExecutionPolicy>(other.data_.GetAddress(), other.size_, begin());
+        CountAllocation(data_);
     }
 
     // Деструктор.Разрушает содержащиеся в векторе элементы и
@@ -141,7 +617,7 @@ public:
     // Алгоритмическая сложность : O(размер вектора).
     ~Vector()
     {
-        std::destroy_n(begin(), size_);
+        detail::DestroyN<ExecutionPolicy>(begin(), size_);
     }
 
     // Конструктор перемещения (Vector move constructor)
@@ -159,54 +635,71 @@ public:
             return *this;
         }
 
-        if (data_.Capacity() < rhs.size_)
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
         {
-            // Выделяем новую память, если текущей емкости недостаточно
-            RawMemory<T> new_data(rhs.size_);
-            std::uninitialized_copy_n(rhs.data_.GetAddress(), rhs.size_, new_data.GetAddress());
-            std::destroy_n(begin(), size_); // Уничтожаем старые данные
-            data_.Swap(new_data); // Поменяем местами буферы, чтобы использовать новые данные
-        }
-        else
-        {
-            // Копируем элементы из исходного вектора в текущий вектор
-            std::copy(rhs.begin(), rhs.begin() + std::min(size_, rhs.size_), begin());  // + Цикл заменен на std::copy
-
-            // Если исходный вектор имеет больше элементов, копируем оставшиеся элементы в свободное пространство
-            if (size_ < rhs.size_)
+            if (data_.GetAllocator() != rhs.data_.GetAllocator())
             {
-                std::uninitialized_copy(rhs.data_.GetAddress() + size_, rhs.data_.GetAddress() + rhs.size_, begin() + size_);
-            }
-            // Если в исходном векторе меньше элементов, уничтожаем лишние элементы в принимающем векторе
-            else if (size_ > rhs.size_)
-            {
-                std::destroy_n(begin() + rhs.size_, size_ - rhs.size_);
+                // Текущий аллокатор не сможет освободить память, выделенную аллокатором rhs,
+                // поэтому копия строится в новом буфере, выделенном аллокатором rhs
+                RawMemory<T, Alloc> new_data(rhs.size_, rhs.data_.GetAllocator());
+                detail::UninitializedCopyN<ExecutionPolicy>(rhs.data_.GetAddress(), rhs.size_, new_data.GetAddress());
+                detail::DestroyN<ExecutionPolicy>(begin(), size_);
+                data_.Swap(new_data);
+                size_ = rhs.size_;
+                CountAllocation(data_);
+                return *this;
             }
+            data_.GetAllocator() = rhs.data_.GetAllocator();
         }
 
-        size_ = rhs.size_;
+        AssignN(rhs.data_.GetAddress(), rhs.size_);
         return *this;
     }
 
-    Vector& operator=(Vector&& rhs) noexcept
+    // Если аллокатор не распространяется при перемещении и аллокаторы не равны,
+    // забрать буфер rhs нельзя, и элементы перемещаются поштучно.
+    Vector& operator=(Vector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                             || AllocTraits::is_always_equal::value)
     {
         if (this == &rhs)
         {
             return *this;
         }
 
-        Swap(rhs);  // + Использован Swap (класса Vector)
+        if constexpr (!AllocTraits::propagate_on_container_move_assignment::value
+                      && !AllocTraits::is_always_equal::value)
+        {
+            if (data_.GetAllocator() != rhs.data_.GetAllocator())
+            {
+                AssignN(std::make_move_iterator(rhs.begin()), rhs.size_);
+                return *this;
+            }
+        }
+
+        data_.Swap(rhs.data_);
+        std::swap(size_, rhs.size_);
 
         return *this;
     }
 
-    // Обменивать содержимое двух объектов Vector
+    // Обменивать содержимое двух объектов Vector.
+    // Если аллокатор не распространяется при обмене, аллокаторы векторов обязаны быть равны
     void Swap(Vector& other) noexcept
     {
+        if constexpr (!AllocTraits::propagate_on_container_swap::value)
+        {
+            assert(data_.GetAllocator() == other.data_.GetAllocator());
+        }
+
         data_.Swap(other.data_);
         std::swap(size_, other.size_);
     }
 
+    allocator_type GetAllocator() const
+    {
+        return data_.GetAllocator();
+    }
+
     // Метод void Reserve(size_t capacity).Резервирует достаточно места,
     // чтобы вместить количество элементов, равное capacity.
     // Если новая вместимость не превышает текущую, метод не делает ничего.
@@ -218,31 +711,55 @@ public:
             return;
         }
 
-        RawMemory<T> new_data(new_capacity);
+        ReallocateTo(new_capacity);
+    }
 
-        UninitializedCopyOrMove(begin(), size_, new_data.GetAddress());  // + Дополнительный метод для инициализации
+    // Уменьшает вместимость до new_capacity, но не ниже размера вектора.
+    // Если вместимость уже не больше требуемой, метод не делает ничего.
+    // Алгоритмическая сложность: O(размер вектора).
+    void ShrinkTo(size_t new_capacity)
+    {
+        new_capacity = std::max(new_capacity, size_);
+        if (new_capacity >= data_.Capacity())
+        {
+            return;
+        }
 
-        std::destroy_n(begin(), size_);
-        data_.Swap(new_data);
+        ReallocateTo(new_capacity);
+    }
+
+    // Освобождает неиспользуемую память, уменьшая вместимость до размера вектора
+    void ShrinkToFit()
+    {
+        ShrinkTo(size_);
     }
 
     void Resize(size_t new_size)
     {
-        if (new_size > size_)
-        {
-            if (new_size > data_.Capacity())
+        ResizeWith(new_size, [](T* first, size_t count)
             {
-                Reserve(new_size);
-            }
+                std::uninitialized_value_construct_n(first, count);
+            });
+    }
 
-            std::uninitialized_value_construct_n(begin() + size_, new_size - size_);
-        }
-        else if (new_size < size_)
-        {
-            std::destroy_n(begin() + new_size, size_ - new_size);
-        }
+    // Изменяет размер вектора, инициализируя новые элементы по умолчанию (default-initialization).
+    // Для тривиальных типов память новых элементов не заполняется нулями.
+    void ResizeDefaultInit(size_t new_size)
+    {
+        ResizeWith(new_size, [](T* first, size_t count)
+            {
+                std::uninitialized_default_construct_n(first, count);
+            });
+    }
 
-        size_ = new_size;
+    // Изменяет размер вектора, оставляя новые элементы неинициализированными.
+    // Предназначен для буферов, которые сразу будут перезаписаны (read(), декодирование и т.п.).
+    // Алгоритмическая сложность: O(1), если не требуется реаллокация.
+    void ResizeUninitialized(size_t new_size)
+    {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                      "ResizeUninitialized requires a trivial element type");
+        ResizeDefaultInit(new_size);
     }
 
     void PushBack(const T& value)
@@ -261,12 +778,47 @@ public:
         return *(Emplace(end(), std::forward<Args>(args)...));
     }
 
+    // Заменяет содержимое вектора элементами диапазона [first, last).
+    // Диапазон не должен указывать на элементы этого вектора.
+    // Алгоритмическая сложность: O(размер вектора + размер диапазона).
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    void Assign(InputIt first, InputIt last)
+    {
+        if constexpr (detail::IsForwardIteratorV<InputIt>)
+        {
+            AssignN(first, static_cast<size_t>(std::distance(first, last)));
+        }
+        else
+        {
+            Clear();
+            Append(first, last);
+        }
+    }
+
+    // Добавляет элементы диапазона [first, last) в конец вектора.
+    // Для однонаправленных итераторов выполняется не более одной реаллокации.
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    void Append(InputIt first, InputIt last)
+    {
+        Insert(cend(), first, last);
+    }
+
+    // Разрушает все элементы вектора. Вместимость не изменяется
+    void Clear() noexcept
+    {
+        std::destroy_n(begin(), size_);
+        size_ = 0;
+        ShrinkIfNeeded();
+        data_.Discard(0);
+    }
+
     void PopBack() /* noexcept */
     {
         if (size_ > 0)
         {
             std::destroy_at(end() - 1);
             --size_;
+            ShrinkIfNeeded();
         }
     }
 
@@ -322,20 +874,82 @@ public:
     {
         assert(pos >= begin() && pos < end());
 
-        size_t index = pos - begin();
+        return Erase(pos, pos + 1);
+    }
 
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+    // Удаляет элементы диапазона [first, last), сдвигая хвост один раз.
+    // Возвращает итератор на элемент, следующий за удалёнными.
+    // Алгоритмическая сложность: O(размер вектора).
+    iterator Erase(const_iterator first, const_iterator last)
+    {
+        assert(first >= begin() && first <= last && last <= end());
+
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        if (count == 0)
         {
-            std::move(begin() + index + 1, end(), begin() + index);
+            return begin() + index;
+        }
+
+        T* dst = begin() + index;
+        T* src = dst + count;
+
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            // Хвост сдвигается одним memmove на место разрушенных элементов
+            std::destroy_n(dst, count);
+            detail::RelocateOverlapping(src, end() - src, dst);
         }
         else
         {
-            std::copy(begin() + index + 1, end(), begin() + index);
+            if constexpr (detail::PreferMoveV<T>)
+            {
+                std::move(src, end(), dst);
+            }
+            else
+            {
+                std::copy(src, end(), dst);
+            }
+
+            std::destroy_n(end() - count, count);
         }
 
-        std::destroy_at(end() - 1);
+        StatsPolicy::OnShift((size_ - index - count) * sizeof(T));
+        size_ -= count;
+        ShrinkIfNeeded();
+        return begin() + index;
+    }
+
+    // Удаляет элемент, перенося на его место последний элемент вектора. Порядок элементов не сохраняется.
+    // Возвращает итератор на элемент, занявший место удалённого (или end(), если удалён последний).
+    // Алгоритмическая сложность: O(1).
+    iterator SwapErase(const_iterator pos)
+    {
+        assert(pos >= begin() && pos < end());
+
+        const size_t index = pos - begin();
+        T* target = begin() + index;
+        T* last = end() - 1;
+
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            std::destroy_at(target);
+            if (target != last)
+            {
+                detail::Relocate(last, 1, target);
+            }
+        }
+        else
+        {
+            if (target != last)
+            {
+                *target = detail::MoveOrCopy(*last);
+            }
+            std::destroy_at(last);
+        }
 
         --size_;
+        ShrinkIfNeeded();
         return begin() + index;
     }
 
@@ -349,6 +963,50 @@ public:
         return Emplace(pos, std::move(value));
     }
 
+    // Вставляет элементы диапазона [first, last) перед pos и возвращает итератор на первый вставленный элемент.
+    // Для однонаправленных итераторов итоговый размер вычисляется заранее: память перевыделяется
+    // не более одного раза, а хвост вектора сдвигается один раз.
+    // Диапазон не должен указывать на элементы этого вектора.
+    // Алгоритмическая сложность: O(размер вектора + размер диапазона).
+    template <typename InputIt, typename = detail::RequireInputIterator<InputIt>>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        assert(pos >= begin() && pos <= end());
+
+        const size_t index = pos - begin();
+
+        if constexpr (detail::IsForwardIteratorV<InputIt>)
+        {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (count == 0)
+            {
+                return begin() + index;
+            }
+
+            if (size_ + count > data_.Capacity())
+            {
+                InsertRangeReallocate(index, first, last, count);
+            }
+            else
+            {
+                InsertRangeWithoutReallocate(index, first, last, count);
+            }
+        }
+        else
+        {
+            // Длина диапазона заранее неизвестна: элементы добавляются в конец и затем поворачиваются на место
+            const size_t old_size = size_;
+            for (; first != last; ++first)
+            {
+                EmplaceBack(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+            StatsPolicy::OnShift((old_size - index) * sizeof(T));
+        }
+
+        return begin() + index;
+    }
+
     size_t Size() const noexcept
     {
         return size_;
@@ -371,29 +1029,165 @@ public:
     }
 
 private:
-    RawMemory<T> data_;
+    RawMemory<T, Alloc> data_;
     size_t size_ = 0;
 
     template <typename... Args>
     iterator EmplaceReallocate(size_t index, Args&&... args)
     {
-        size_t new_capacity = (size_ == 0) ? 1 : size_ * 2;
-        RawMemory<T> new_data(new_capacity);
+        size_t new_capacity = NextCapacity(size_ + 1);
+
+        if constexpr (IsTriviallyRelocatableV<T> && AllocatorHasReallocateV<Alloc>)
+        {
+            // Новый элемент создаётся до реаллокации: аргументы могут ссылаться на элементы текущего буфера
+            alignas(T) unsigned char storage[sizeof(T)];
+            T* temp = new (storage) T(std::forward<Args>(args)...);
+            try
+            {
+                data_.Reallocate(new_capacity);
+            }
+            catch (...)
+            {
+                std::destroy_at(temp);
+                throw;
+            }
+            detail::RelocateOverlapping(begin() + index, size_ - index, begin() + index + 1);
+            detail::Relocate(temp, 1, begin() + index);
+            CountReallocation();
+            ++size_;
+            return begin() + index;
+        }
+
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            // Новый элемент создаётся до переноса: аргументы могут ссылаться на элементы старого буфера
+            new (new_data.GetAddress() + index) T(std::forward<Args>(args)...);
 
-        UninitializedCopyOrMove(begin(), index, new_data.GetAddress());  // + Дополнительный метод для инициализации
-        UninitializedCopyOrMove(begin() + index, size_ - index, new_data.GetAddress() + index + 1);  // + Дополнительный метод для инициализации
+            detail::Relocate(begin(), index, new_data.GetAddress());
+            detail::Relocate(begin() + index, size_ - index, new_data.GetAddress() + index + 1);
+        }
+        else
+        {
+            detail::UninitializedCopyOrMove(begin(), index, new_data.GetAddress());  // + Дополнительный метод для инициализации
+            detail::UninitializedCopyOrMove(begin() + index, size_ - index, new_data.GetAddress() + index + 1);  // + Дополнительный метод для инициализации
 
-        new (new_data.GetAddress() + index) T(std::forward<Args>(args)...);
+            new (new_data.GetAddress() + index) T(std::forward<Args>(args)...);
 
-        std::destroy_n(data_.GetAddress(), size_);
+            std::destroy_n(data_.GetAddress(), size_);
+        }
         data_.Swap(new_data);
+        CountReallocation();
         ++size_;
         return begin() + index;
     }
 
+    template <typename ForwardIt>
+    void InsertRangeReallocate(size_t index, ForwardIt first, ForwardIt last, size_t count)
+    {
+        RawMemory<T, Alloc> new_data(NextCapacity(size_ + count), data_.GetAllocator());
+        T* new_begin = new_data.GetAddress();
+
+        // Вставляемые элементы создаются первыми: при исключении исходный вектор не изменяется
+        std::uninitialized_copy(first, last, new_begin + index);
+
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::Relocate(begin(), index, new_begin);
+            detail::Relocate(begin() + index, size_ - index, new_begin + index + count);
+        }
+        else
+        {
+            try
+            {
+                detail::UninitializedCopyOrMove(begin(), index, new_begin);
+            }
+            catch (...)
+            {
+                std::destroy_n(new_begin + index, count);
+                throw;
+            }
+            try
+            {
+                detail::UninitializedCopyOrMove(begin() + index, size_ - index, new_begin + index + count);
+            }
+            catch (...)
+            {
+                std::destroy_n(new_begin, index + count);
+                throw;
+            }
+            std::destroy_n(begin(), size_);
+        }
+
+        data_.Swap(new_data);
+        CountReallocation();
+        size_ += count;
+    }
+
+    template <typename ForwardIt>
+    void InsertRangeWithoutReallocate(size_t index, ForwardIt first, ForwardIt last, size_t count)
+    {
+        T* pos = begin() + index;
+        T* old_end = end();
+        const size_t elems_after = size_ - index;
+
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            // Хвост сдвигается одним memmove, в освободившуюся память копируется диапазон
+            detail::RelocateOverlapping(pos, elems_after, pos + count);
+            try
+            {
+                std::uninitialized_copy(first, last, pos);
+            }
+            catch (...)
+            {
+                detail::RelocateOverlapping(pos + count, elems_after, pos);
+                throw;
+            }
+            size_ += count;
+        }
+        else if (elems_after > count)
+        {
+            // Последние count элементов переезжают в неинициализированную память,
+            // остальная часть хвоста сдвигается присваиванием
+            detail::UninitializedCopyOrMove(old_end - count, count, old_end);
+            size_ += count;
+            std::move_backward(pos, old_end - count, old_end);
+            std::copy(first, last, pos);
+        }
+        else
+        {
+            // Диапазон выходит за старый конец: его окончание и хвост создаются в неинициализированной памяти
+            ForwardIt mid = first;
+            std::advance(mid, elems_after);
+            std::uninitialized_copy(mid, last, old_end);
+            size_ += count - elems_after;
+            detail::UninitializedCopyOrMove(pos, elems_after, end());
+            size_ += elems_after;
+            std::copy(first, mid, pos);
+        }
+        StatsPolicy::OnShift(elems_after * sizeof(T));
+    }
+
     template <typename... Args>
     iterator EmplaceWithoutReallocate(size_t index, Args&&... args)
     {
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            if (index < size_)
+            {
+                // Временный объект создаётся в сырой памяти, чтобы затем перенести его в вектор без перемещения
+                alignas(T) unsigned char storage[sizeof(T)];
+                T* temp = new (storage) T(std::forward<Args>(args)...);
+                detail::RelocateOverlapping(begin() + index, size_ - index, begin() + index + 1);
+                detail::Relocate(temp, 1, begin() + index);
+                StatsPolicy::OnShift((size_ - index) * sizeof(T));
+                ++size_;
+                return begin() + index;
+            }
+        }
+
         if (index < size_)
         {
             T temp(std::forward<Args>(args)...);
@@ -401,6 +1195,7 @@ private:
             std::move_backward(begin() + index, end() - 1, end());
 
             *(data_.GetAddress() + index) = std::move(temp);
+            StatsPolicy::OnShift((size_ - index) * sizeof(T));
         }
         else
         {
@@ -410,16 +1205,170 @@ private:
         return begin() + index;
     }
 
-    template <typename InputIt, typename OutputIt>
-    static void UninitializedCopyOrMove(InputIt first, size_t count, OutputIt result)
+    // Переносит элементы в буфер вместимостью new_capacity (не меньше размера вектора)
+    void ReallocateTo(size_t new_capacity)
     {
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+        if constexpr (IsTriviallyRelocatableV<T> && AllocatorHasReallocateV<Alloc>)
         {
-            std::uninitialized_move_n(first, count, result);
+            // Буфер изменяет размер на месте, если аллокатор это позволяет
+            data_.Reallocate(new_capacity);
+            CountReallocation();
+            return;
+        }
+
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+
+        if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            detail::Relocate(begin(), size_, new_data.GetAddress());
         }
         else
         {
-            std::uninitialized_copy_n(first, count, result);
+            detail::UninitializedCopyOrMove(begin(), size_, new_data.GetAddress());  // + Дополнительный метод для инициализации
+
+            std::destroy_n(begin(), size_);
+        }
+        data_.Swap(new_data);
+        CountReallocation();
+    }
+
+    // Автоматически уменьшает вместимость после удаления элементов, если этого требует политика роста.
+    // Уменьшение вместимости - лишь оптимизация, поэтому ошибка реаллокации не передаётся вызывающему
+    void ShrinkIfNeeded() noexcept
+    {
+        if constexpr (GrowthPolicyHasShrinkV<GrowthPolicy>)
+        {
+            const size_t target = GrowthPolicy::ShrinkCapacity(size_, data_.Capacity(), sizeof(T));
+            if (target < data_.Capacity())
+            {
+                try
+                {
+                    ReallocateTo(std::max(target, size_));
+                }
+                catch (...)
+                {
+                }
+            }
+        }
+    }
+
+    // Изменяет размер вектора, создавая недостающие элементы функцией construct(first, count)
+    template <typename Construct>
+    void ResizeWith(size_t new_size, Construct construct)
+    {
+        if (new_size > size_)
+        {
+            if (new_size > data_.Capacity())
+            {
+                Reserve(new_size);
+            }
+
+            construct(begin() + size_, new_size - size_);
+        }
+        else if (new_size < size_)
+        {
+            std::destroy_n(begin() + new_size, size_ - new_size);
+            size_ = new_size;
+            ShrinkIfNeeded();
+            data_.Discard(size_);
         }
+
+        size_ = new_size;
+    }
+
+    static void CountAllocation(const RawMemory<T, Alloc>& memory) noexcept
+    {
+        if (memory.Capacity() != 0)
+        {
+            StatsPolicy::OnAllocate(memory.Capacity() * sizeof(T));
+        }
+    }
+
+    // Учитывает переход в новый буфер data_, в который перенесены size_ прежних элементов
+    void CountReallocation() const noexcept
+    {
+        CountAllocation(data_);
+        if (size_ != 0)
+        {
+            StatsPolicy::OnRelocate(size_ * sizeof(T));
+        }
+    }
+
+    // Вместимость, до которой вектор растёт, когда ему требуется место под required элементов
+    size_t NextCapacity(size_t required) const noexcept
+    {
+        return std::max(GrowthPolicy::NextCapacity(data_.Capacity(), sizeof(T)), required);
+    }
+
+    // Заменяет содержимое вектора n элементами, начиная с first.
+    // Имеющиеся элементы переиспользуются присваиванием, новая память выделяется только при нехватке вместимости.
+    // При параллельном выполнении копия всегда строится в новом буфере: исключение в одной из частей
+    // не должно оставить вектор с уже перезаписанным началом (строгая гарантия безопасности исключений)
+    template <typename InputIt>
+    void AssignN(InputIt first, size_t n)
+    {
+        if (data_.Capacity() < n || !std::is_same_v<ExecutionPolicy, SequentialExecution>)
+        {
+            // Выделяем новую память, если текущей емкости недостаточно
+            RawMemory<T, Alloc> new_data(n, data_.GetAllocator());
+            detail::UninitializedCopyN<ExecutionPolicy>(first, n, new_data.GetAddress());
+            detail::DestroyN<ExecutionPolicy>(begin(), size_); // Уничтожаем старые данные
+            data_.Swap(new_data); // Поменяем местами буферы, чтобы использовать новые данные
+            CountAllocation(data_);
+        }
+        else
+        {
+            // Копируем элементы из исходного диапазона в текущий вектор
+            const size_t common = std::min(size_, n);
+            for (size_t i = 0; i < common; ++i, ++first)
+            {
+                data_[i] = *first;
+            }
+
+            // Если в исходном диапазоне больше элементов, копируем оставшиеся элементы в свободное пространство
+            if (size_ < n)
+            {
+                detail::UninitializedCopyN<ExecutionPolicy>(first, n - size_, begin() + size_);
+            }
+            // Если в исходном диапазоне меньше элементов, уничтожаем лишние элементы в принимающем векторе
+            else if (size_ > n)
+            {
+                std::destroy_n(begin() + n, size_ - n);
+            }
+        }
+
+        size_ = n;
     }
 };
+
+// Вектор хранит лишь указатель на буфер, размер и аллокатор,
+// поэтому его можно переносить побайтово, если это допускает аллокатор
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+struct IsTriviallyRelocatable<Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>> : IsTriviallyRelocatable<Alloc> {};
+
+// Удаляет из вектора все элементы, удовлетворяющие предикату, за один проход.
+// Оставшиеся элементы сохраняют порядок и сдвигаются не более одного раза.
+// Возвращает количество удалённых элементов.
+// Алгоритмическая сложность: O(размер вектора).
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy, typename Predicate>
+size_t EraseIf(Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& vector, Predicate pred)
+{
+    T* first = std::find_if(vector.begin(), vector.end(), pred);
+    if (first == vector.end())
+    {
+        return 0;
+    }
+
+    for (T* it = first + 1; it != vector.end(); ++it)
+    {
+        if (!pred(*it))
+        {
+            *first = detail::MoveOrCopy(*it);
+            ++first;
+        }
+    }
+
+    const size_t removed = vector.end() - first;
+    vector.Erase(first, vector.end());
+    return removed;
+}
@@ -0,0 +1,312 @@
+#pragma once
+#include "vector.h"
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+// Заголовок двоичного представления вектора. За ним следуют count элементов подряд
+struct VectorStreamHeader
+{
+    static constexpr uint64_t MAGIC = 0x4d41455254534156;  // "VASTREAM"
+    static constexpr uint32_t VERSION = 1;
+    // Число элементов неизвестно: поток читается до конца файла
+    static constexpr uint64_t UNKNOWN_COUNT = UINT64_MAX;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t element_size;
+    uint64_t count;
+};
+
+namespace detail
+{
+    [[noreturn]] inline void ThrowSystemError(const char* what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Записывает все буферы iov целиком, повторяя writev после частичной записи и EINTR
+    inline void WriteAll(int fd, iovec* iov, int iov_count)
+    {
+        while (iov_count > 0)
+        {
+            ssize_t written = writev(fd, iov, iov_count);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ThrowSystemError("writev");
+            }
+            size_t rest = static_cast<size_t>(written);
+            while (iov_count > 0 && rest >= iov->iov_len)
+            {
+                rest -= iov->iov_len;
+                ++iov;
+                --iov_count;
+            }
+            if (iov_count > 0)
+            {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + rest;
+                iov->iov_len -= rest;
+            }
+        }
+    }
+
+    // Читает до size байт. Меньше прочитанных байт означает конец файла.
+    // Здесь используется read, а не readv: заголовок нужно проверить раньше, чем выделять буфер под элементы,
+    // поэтому заголовок и элементы в один вызов не читаются, а readv с одним буфером ничем не отличается от read
+    inline size_t ReadSome(int fd, void* buffer, size_t size)
+    {
+        size_t total = 0;
+        while (total < size)
+        {
+            ssize_t n = read(fd, static_cast<char*>(buffer) + total, size - total);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ThrowSystemError("read");
+            }
+            if (n == 0)
+            {
+                break;
+            }
+            total += static_cast<size_t>(n);
+        }
+        return total;
+    }
+
+    inline void ReadAll(int fd, void* buffer, size_t size)
+    {
+        if (ReadSome(fd, buffer, size) != size)
+        {
+            throw std::runtime_error("Unexpected end of vector stream");
+        }
+    }
+}  // namespace detail
+
+// Записывает вектор в файловый дескриптор: заголовок и элементы уходят одним вызовом writev
+// прямо из буфера вектора, без поэлементного копирования
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+void WriteVector(int fd, const Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& v)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be serialized");
+
+    VectorStreamHeader header{ VectorStreamHeader::MAGIC, VectorStreamHeader::VERSION, sizeof(T), v.Size() };
+    iovec iov[2] = {
+        { &header, sizeof(header) },
+        { const_cast<T*>(v.begin()), v.Size() * sizeof(T) },
+    };
+    detail::WriteAll(fd, iov, 2);
+}
+
+// Потоковая запись вектора частями, когда он целиком не помещается в память.
+// Число элементов дописывается в заголовок в Finish() через pwrite. Если дескриптор
+// не поддерживает позиционирование (канал, сокет) или Finish() не был вызван,
+// в заголовке остаётся UNKNOWN_COUNT и поток читается до конца файла
+template <typename T>
+class VectorWriter
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be serialized");
+
+public:
+    explicit VectorWriter(int fd) : fd_(fd), header_offset_(lseek(fd, 0, SEEK_CUR))
+    {
+        VectorStreamHeader header{ VectorStreamHeader::MAGIC, VectorStreamHeader::VERSION, sizeof(T), VectorStreamHeader::UNKNOWN_COUNT };
+        iovec iov{ &header, sizeof(header) };
+        detail::WriteAll(fd_, &iov, 1);
+    }
+
+    VectorWriter(const VectorWriter&) = delete;
+
+    VectorWriter& operator=(const VectorWriter&) = delete;
+
+    void Write(const T* data, size_t count)
+    {
+        iovec iov{ const_cast<T*>(data), count * sizeof(T) };
+        detail::WriteAll(fd_, &iov, 1);
+        count_ += count;
+    }
+
+    template <typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+    void Write(const Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& chunk)
+    {
+        Write(chunk.begin(), chunk.Size());
+    }
+
+    // Записывает в заголовок итоговое число элементов
+    void Finish()
+    {
+        if (header_offset_ < 0)
+        {
+            return;
+        }
+        const uint64_t count = count_;
+        const off_t offset = header_offset_ + static_cast<off_t>(offsetof(VectorStreamHeader, count));
+        for (size_t written = 0; written < sizeof(count);)
+        {
+            ssize_t n = pwrite(fd_, reinterpret_cast<const char*>(&count) + written, sizeof(count) - written,
+                               offset + static_cast<off_t>(written));
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                detail::ThrowSystemError("pwrite");
+            }
+            written += static_cast<size_t>(n);
+        }
+    }
+
+    size_t Count() const noexcept
+    {
+        return count_;
+    }
+
+private:
+    int fd_;
+    off_t header_offset_;
+    size_t count_ = 0;
+};
+
+// Потоковое чтение вектора частями.
+// Выбрасывает std::runtime_error, если поток повреждён или записан для элементов другого размера,
+// и std::system_error при ошибке ввода-вывода
+template <typename T>
+class VectorReader
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be serialized");
+
+public:
+    explicit VectorReader(int fd) : fd_(fd)
+    {
+        VectorStreamHeader header;
+        detail::ReadAll(fd_, &header, sizeof(header));
+        if (header.magic != VectorStreamHeader::MAGIC || header.version != VectorStreamHeader::VERSION)
+        {
+            throw std::runtime_error("Not a vector stream");
+        }
+        if (header.element_size != sizeof(T))
+        {
+            throw std::runtime_error("Vector stream element size mismatch");
+        }
+        remaining_ = header.count;
+        if (remaining_ == VectorStreamHeader::UNKNOWN_COUNT)
+        {
+            return;
+        }
+        // Число элементов из заголовка проверяется до выделения памяти: повреждённый заголовок
+        // не должен приводить к переполнению размера или к огромному выделению
+        if (remaining_ > SIZE_MAX / sizeof(T))
+        {
+            throw std::runtime_error("Vector stream element count is too large");
+        }
+        // В обычном файле число элементов сверяется с его размером, и тогда ReadAll читает их одним вызовом
+        struct stat st;
+        const off_t position = lseek(fd_, 0, SEEK_CUR);
+        if (position >= 0 && fstat(fd_, &st) == 0 && S_ISREG(st.st_mode))
+        {
+            if (st.st_size < position || remaining_ * sizeof(T) > static_cast<uint64_t>(st.st_size - position))
+            {
+                throw std::runtime_error("Unexpected end of vector stream");
+            }
+            count_verified_ = true;
+        }
+    }
+
+    VectorReader(const VectorReader&) = delete;
+
+    VectorReader& operator=(const VectorReader&) = delete;
+
+    // Все элементы прочитаны
+    bool Done() const noexcept
+    {
+        return remaining_ == 0;
+    }
+
+    // Читает до max_count элементов в chunk, заменяя его содержимое. Возвращает число прочитанных элементов
+    template <typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+    size_t ReadChunk(Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& chunk, size_t max_count)
+    {
+        chunk.Clear();
+        return ReadAppend(chunk, max_count);
+    }
+
+    // Читает оставшиеся элементы, дописывая их в конец v.
+    // Если число элементов сверено с размером файла, они читаются одним вызовом в буфер нужного размера.
+    // Иначе (канал, сокет, неизвестное число) чтение идёт частями удваивающегося размера: память
+    // выделяется не больше чем вдвое сверх реально прочитанных данных, сколько бы ни обещал заголовок
+    template <typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+    void ReadAll(Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& v)
+    {
+        if (count_verified_)
+        {
+            ReadAppend(v, static_cast<size_t>(remaining_));
+            return;
+        }
+        for (size_t chunk_size = std::max<size_t>(4096 / sizeof(T), 1); !Done();
+             chunk_size = std::min(chunk_size * 2, SIZE_MAX / sizeof(T) / 2))
+        {
+            ReadAppend(v, chunk_size);
+        }
+    }
+
+private:
+    template <typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+    size_t ReadAppend(Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& v, size_t max_count)
+    {
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(max_count, remaining_));
+        const size_t old_size = v.Size();
+        if (count > SIZE_MAX / sizeof(T) - old_size)
+        {
+            throw std::runtime_error("Vector stream element count is too large");
+        }
+        // Элементы читаются прямо в буфер вектора; для тривиальных типов он не инициализируется
+        v.ResizeDefaultInit(old_size + count);
+        const size_t bytes = detail::ReadSome(fd_, v.begin() + old_size, count * sizeof(T));
+        if (bytes % sizeof(T) != 0 || (bytes < count * sizeof(T) && remaining_ != VectorStreamHeader::UNKNOWN_COUNT))
+        {
+            v.ResizeDefaultInit(old_size);
+            throw std::runtime_error("Unexpected end of vector stream");
+        }
+        const size_t read = bytes / sizeof(T);
+        v.ResizeDefaultInit(old_size + read);
+        if (remaining_ == VectorStreamHeader::UNKNOWN_COUNT)
+        {
+            if (read < count)
+            {
+                remaining_ = 0;
+            }
+        }
+        else
+        {
+            remaining_ -= read;
+        }
+        return read;
+    }
+
+    int fd_;
+    uint64_t remaining_ = 0;
+    // Число элементов из заголовка не превышает размера файла
+    bool count_verified_ = false;
+};
+
+// Читает вектор, записанный WriteVector или VectorWriter, заменяя содержимое v
+template <typename T, typename Alloc, typename GrowthPolicy, typename ExecutionPolicy, typename StatsPolicy>
+void ReadVector(int fd, Vector<T, Alloc, GrowthPolicy, ExecutionPolicy, StatsPolicy>& v)
+{
+    VectorReader<T> reader(fd);
+    v.Clear();
+    reader.ReadAll(v);
+}
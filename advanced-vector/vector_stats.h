@@ -0,0 +1,183 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <mutex>
+#include <ostream>
+
+// Счётчики событий векторов одного тега. Обновляются атомарно: векторы с одним тегом
+// могут работать в разных потоках
+struct VectorStatsCounters
+{
+    std::atomic<uint64_t> allocations{ 0 };
+    std::atomic<uint64_t> allocated_bytes{ 0 };
+    std::atomic<uint64_t> reallocations{ 0 };
+    std::atomic<uint64_t> relocated_bytes{ 0 };
+    std::atomic<uint64_t> shifts{ 0 };
+    std::atomic<uint64_t> shifted_bytes{ 0 };
+    std::atomic<uint64_t> peak_capacity_bytes{ 0 };
+};
+
+// Значения счётчиков тега на момент снимка
+struct VectorStatsSnapshot
+{
+    const char* tag;
+    // Выделения буферов (включая реаллокации) и их суммарная вместимость в байтах
+    uint64_t allocations;
+    uint64_t allocated_bytes;
+    // Реаллокации и объём элементов, перенесённых в новые буферы
+    uint64_t reallocations;
+    uint64_t relocated_bytes;
+    // Сдвиги хвоста при вставке и удалении внутри буфера и их объём
+    uint64_t shifts;
+    uint64_t shifted_bytes;
+    // Наибольшая вместимость одного буфера
+    uint64_t peak_capacity_bytes;
+};
+
+// Глобальный реестр счётчиков VectorStats по тегам.
+// Реестр намеренно не разрушается: векторы со статическим временем жизни обновляют счётчики
+// и во время завершения программы
+class VectorStatsRegistry
+{
+public:
+    static VectorStatsRegistry& Instance()
+    {
+        static VectorStatsRegistry* registry = new VectorStatsRegistry();
+        return *registry;
+    }
+
+    VectorStatsRegistry(const VectorStatsRegistry&) = delete;
+
+    VectorStatsRegistry& operator=(const VectorStatsRegistry&) = delete;
+
+    void Register(const char* tag, VectorStatsCounters* counters)
+    {
+        std::lock_guard lock(mutex_);
+        entries_.PushBack({ tag, counters });
+    }
+
+    // Снимок счётчиков всех тегов, упорядоченный по убыванию выделенных байт:
+    // в начале - теги, создающие основную нагрузку на аллокатор
+    Vector<VectorStatsSnapshot> Snapshot() const
+    {
+        Vector<VectorStatsSnapshot> result;
+        {
+            std::lock_guard lock(mutex_);
+            result.Reserve(entries_.Size());
+            for (const Entry& entry : entries_)
+            {
+                const VectorStatsCounters& c = *entry.counters;
+                result.PushBack({ entry.tag, Load(c.allocations), Load(c.allocated_bytes), Load(c.reallocations),
+                                  Load(c.relocated_bytes), Load(c.shifts), Load(c.shifted_bytes),
+                                  Load(c.peak_capacity_bytes) });
+            }
+        }
+        std::stable_sort(result.begin(), result.end(), [](const VectorStatsSnapshot& lhs, const VectorStatsSnapshot& rhs) {
+            return lhs.allocated_bytes > rhs.allocated_bytes;
+        });
+        return result;
+    }
+
+    // Выводит снимок по строке на тег
+    void Dump(std::ostream& out) const
+    {
+        for (const VectorStatsSnapshot& s : Snapshot())
+        {
+            out << s.tag << ": allocations=" << s.allocations << " allocated_bytes=" << s.allocated_bytes
+                << " reallocations=" << s.reallocations << " relocated_bytes=" << s.relocated_bytes
+                << " shifts=" << s.shifts << " shifted_bytes=" << s.shifted_bytes
+                << " peak_capacity_bytes=" << s.peak_capacity_bytes << '\n';
+        }
+    }
+
+    // Обнуляет счётчики всех тегов
+    void Reset() noexcept
+    {
+        std::lock_guard lock(mutex_);
+        for (const Entry& entry : entries_)
+        {
+            VectorStatsCounters& c = *entry.counters;
+            for (std::atomic<uint64_t>* counter : { &c.allocations, &c.allocated_bytes, &c.reallocations, &c.relocated_bytes,
+                                                    &c.shifts, &c.shifted_bytes, &c.peak_capacity_bytes })
+            {
+                counter->store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Entry
+    {
+        const char* tag;
+        VectorStatsCounters* counters;
+    };
+
+    VectorStatsRegistry() = default;
+
+    static uint64_t Load(const std::atomic<uint64_t>& counter) noexcept
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    mutable std::mutex mutex_;
+    Vector<Entry> entries_;
+};
+
+// Политика StatsPolicy, собирающая статистику векторов в счётчики тега Tag.
+// Tag - тип с именем места использования: struct OrdersTag { static constexpr const char* NAME = "orders"; };
+// Счётчики регистрируются в VectorStatsRegistry при первом событии.
+// Vector<Order, std::allocator<Order>, DoublingGrowth, SequentialExecution, VectorStats<OrdersTag>> orders;
+template <typename Tag>
+struct VectorStats
+{
+    static void OnAllocate(size_t capacity_bytes) noexcept
+    {
+        VectorStatsCounters& c = Counters();
+        c.allocations.fetch_add(1, std::memory_order_relaxed);
+        c.allocated_bytes.fetch_add(capacity_bytes, std::memory_order_relaxed);
+        uint64_t peak = c.peak_capacity_bytes.load(std::memory_order_relaxed);
+        while (peak < capacity_bytes
+               && !c.peak_capacity_bytes.compare_exchange_weak(peak, capacity_bytes, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    static void OnRelocate(size_t bytes) noexcept
+    {
+        VectorStatsCounters& c = Counters();
+        c.reallocations.fetch_add(1, std::memory_order_relaxed);
+        c.relocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static void OnShift(size_t bytes) noexcept
+    {
+        VectorStatsCounters& c = Counters();
+        c.shifts.fetch_add(1, std::memory_order_relaxed);
+        c.shifted_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static VectorStatsCounters& Counters() noexcept
+    {
+        // Счётчики тривиально разрушаемы и остаются доступны векторам со статическим временем жизни.
+        // Регистрация выделяет память; если это не удалось, счётчики работают без реестра
+        static VectorStatsCounters counters;
+        static const bool registered = [] {
+            try
+            {
+                VectorStatsRegistry::Instance().Register(Tag::NAME, &counters);
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }();
+        (void)registered;
+        return counters;
+    }
+};
+
+// Vector со сбором статистики по тегу Tag
+template <typename T, typename Tag, typename Alloc = std::allocator<T>>
+using TrackedVector = Vector<T, Alloc, DoublingGrowth, SequentialExecution, VectorStats<Tag>>;